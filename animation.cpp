@@ -0,0 +1,33 @@
+// animation.cpp
+#include "animation.h"
+
+//----------------------------------------------------------------------------------
+// Animation Table Implementation
+//----------------------------------------------------------------------------------
+AnimationTable::AnimationTable() {
+    for (BakedClip& clip : clips) clip = { 0, 0, 0.0f };
+}
+
+void AnimationTable::Bake(const Vector2* spriteSizes) {
+    frames.clear();
+    for (const AnimClipDef& def : ANIM_CLIP_DEFS) {
+        Vector2 size = spriteSizes[(int)def.sprite];
+        float frameWidth = size.x / def.numFrames;
+        float frameHeight = size.y / def.sheetRows;
+
+        BakedClip& clip = clips[(int)def.id];
+        clip.firstFrame = (int)frames.size();
+        clip.numFrames = def.numFrames;
+        clip.framesPerSecond = def.numFrames > 1 ? 1.0f / def.frameDuration : 0.0f;
+        for (int frame = 0; frame < def.numFrames; ++frame) {
+            frames.push_back({ frame * frameWidth, def.row * frameHeight, frameWidth, frameHeight });
+        }
+    }
+}
+
+Rectangle AnimationTable::GetFrame(AnimClipId id, float elapsed) const {
+    const BakedClip& clip = clips[(int)id];
+    int frame = 0;
+    if (clip.numFrames > 1 && elapsed > 0.0f) frame = (int)(elapsed * clip.framesPerSecond) % clip.numFrames;
+    return frames[clip.firstFrame + frame];
+}
@@ -0,0 +1,94 @@
+// animation.h
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include "raylib.h"
+#include <vector>
+#include "texture_atlas.h" // For SpriteId
+#include "game_constants.h"
+
+//----------------------------------------------------------------------------------
+// Animation Clips
+// Every sprite sheet animation the simulation plays is a row of the clip table
+// below: which sprite, how the sheet is cut and how long a frame lasts. The
+// AnimationTable bakes each clip's frame rects once, from the sprite sizes.
+//
+// Nothing animates per entity. An entity only remembers which clip it plays and
+// its phase, the simulation clock value the clip started at; the frame shown is
+// derived from the clock when the snapshot is written. Switching clips restarts
+// from frame 0 by moving the phase to the current clock.
+//----------------------------------------------------------------------------------
+enum class AnimClipId {
+    PEASHOOTER_IDLE,
+    SUNFLOWER_IDLE,
+    CHERRY_BOMB_IDLE,
+    WALNUT_IDLE,
+    REPEATER_IDLE,
+    ICE_PEA_IDLE,
+    REGULAR_ZOMBIE_WALK,
+    REGULAR_ZOMBIE_EAT,
+    JUMPING_ZOMBIE_JUMP,  // The jumping zombie's only clip, walking included
+    PEA,                  // Normal and frozen peas
+    COUNT
+};
+
+struct AnimClipDef {
+    AnimClipId id;
+    SpriteId sprite;
+    int numFrames;        // Frames in the clip's row
+    int sheetRows;        // Rows in the whole sheet
+    int row;              // Row the clip plays from
+    float frameDuration;  // Seconds per frame, 0 for single frame clips
+};
+
+// Indexed by AnimClipId
+constexpr AnimClipDef ANIM_CLIP_DEFS[] = {
+    //  id                              sprite                     frames                              rows                               row  seconds per frame
+    { AnimClipId::PEASHOOTER_IDLE,     SpriteId::PEASHOOTER,     1,                                  1,                                 0, 0.0f },
+    { AnimClipId::SUNFLOWER_IDLE,      SpriteId::SUNFLOWER,      1,                                  1,                                 0, 0.0f },
+    { AnimClipId::CHERRY_BOMB_IDLE,    SpriteId::CHERRY_BOMB,    1,                                  1,                                 0, 0.0f },
+    { AnimClipId::WALNUT_IDLE,         SpriteId::WALNUT,         1,                                  1,                                 0, 0.0f },
+    { AnimClipId::REPEATER_IDLE,       SpriteId::REPEATER,       1,                                  1,                                 0, 0.0f },
+    { AnimClipId::ICE_PEA_IDLE,        SpriteId::ICE_PEA,        1,                                  1,                                 0, 0.0f },
+    { AnimClipId::REGULAR_ZOMBIE_WALK, SpriteId::REGULAR_ZOMBIE, REGULAR_ZOMBIE_WALKING_NUM_FRAMES,  REGULAR_ZOMBIE_TOTAL_SPRITE_ROWS,  0, REGULAR_ZOMBIE_WALKING_FRAME_SPEED },
+    { AnimClipId::REGULAR_ZOMBIE_EAT,  SpriteId::REGULAR_ZOMBIE, REGULAR_ZOMBIE_EATING_NUM_FRAMES,   REGULAR_ZOMBIE_TOTAL_SPRITE_ROWS,  1, REGULAR_ZOMBIE_EATING_FRAME_SPEED },
+    { AnimClipId::JUMPING_ZOMBIE_JUMP, SpriteId::JUMPING_ZOMBIE, JUMPING_ZOMBIE_NUM_FRAMES,          JUMPING_ZOMBIE_TOTAL_SPRITE_ROWS,  0, JUMPING_ZOMBIE_FRAME_SPEED },
+    { AnimClipId::PEA,                 SpriteId::PEA,            1,                                  1,                                 0, 0.0f },
+};
+
+constexpr bool ValidateAnimClips() {
+    for (int i = 0; i < (int)(sizeof(ANIM_CLIP_DEFS) / sizeof(ANIM_CLIP_DEFS[0])); ++i) {
+        const AnimClipDef& c = ANIM_CLIP_DEFS[i];
+        if ((int)c.id != i) return false;                                   // Row order matches the enum
+        if (c.numFrames < 1 || c.row < 0 || c.row >= c.sheetRows) return false;
+        if (c.numFrames > 1 && c.frameDuration <= 0.0f) return false;       // Animated clips need a frame time
+    }
+    return true;
+}
+
+static_assert(sizeof(ANIM_CLIP_DEFS) / sizeof(ANIM_CLIP_DEFS[0]) == (int)AnimClipId::COUNT,
+              "ANIM_CLIP_DEFS needs one row per AnimClipId");
+static_assert(ValidateAnimClips(), "Invalid animation clip");
+
+class AnimationTable {
+public:
+    AnimationTable();
+
+    // 'spriteSizes' is indexed by SpriteId; frame rects come out relative to the sprite
+    void Bake(const Vector2* spriteSizes);
+
+    // Frame of 'clip' 'elapsed' seconds after it started, looping
+    Rectangle GetFrame(AnimClipId clip, float elapsed) const;
+
+private:
+    struct BakedClip {
+        int firstFrame;        // Into 'frames'
+        int numFrames;
+        float framesPerSecond; // 0 for single frame clips
+    };
+
+    BakedClip clips[(int)AnimClipId::COUNT];
+    std::vector<Rectangle> frames; // Every clip's frames, back to back
+};
+
+#endif // ANIMATION_H
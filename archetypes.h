@@ -0,0 +1,174 @@
+// archetypes.h
+#ifndef ARCHETYPES_H
+#define ARCHETYPES_H
+
+#include "raylib.h"
+#include "plant.h"          // For PlantType
+#include "zombie.h"         // For ZombieType
+#include "projectile.h"     // For ProjectileType
+#include "status_effects.h" // For StatusEffectType
+#include "texture_atlas.h"  // For SpriteId
+
+//----------------------------------------------------------------------------------
+// Archetype Tables
+// Every tunable stat of plants, zombies and projectiles lives in one of the
+// tables below, indexed by the type enum. They are constexpr, so the checks at
+// the bottom run at compile time and a bad entry fails the build.
+// Per-level zombie stats are precomputed into lookup tables as well: spawning
+// reads a row instead of redoing the scaling math.
+//----------------------------------------------------------------------------------
+struct PlantArchetype {
+    PlantType type;
+    const char* name;
+    bool placeable;          // False for SHOVEL and NONE, which only exist as selections
+    int cost;                // Sun
+    int health;
+    Color color;             // Fallback color
+    float fireRate;          // Seconds between shots, 0 for plants that don't shoot
+    ProjectileType projectile;
+    int projectilesPerShot;
+    float sunInterval;       // Seconds between sun production, 0 if none
+    int sunAmount;
+    SpriteId sprite;         // Lawn sprite and HUD icon, COUNT for none
+};
+
+struct ZombieArchetype {
+    ZombieType type;
+    const char* name;
+    int health;              // Level 1 values, see ZombieLevelStats for the scaled ones
+    float speed;             // Pixels per second
+    int damagePerBite;
+    float biteRate;          // Seconds between bites
+    int scoreValue;
+    Color color;             // Fallback color
+    SpriteId sprite;         // Sprite sheet
+};
+
+struct ProjectileArchetype {
+    ProjectileType type;
+    float speed;             // Pixels per second, along the lane
+    int damage;
+    float width;
+    float height;
+    StatusEffectType effect; // Applied on hit, COUNT for none
+    SpriteId sprite;
+};
+
+// Indexed by PlantType
+constexpr PlantArchetype PLANT_ARCHETYPES[] = {
+    //  type                    name           place  cost  hp   color   fire  projectile              shots  sun    amount  sprite
+    { PlantType::PEASHOOTER,  "Peashooter",  true,   50, 100, GREEN,  1.5f, ProjectileType::NORMAL, 1,  0.0f,   0, SpriteId::PEASHOOTER  },
+    { PlantType::SUNFLOWER,   "Sunflower",   true,   25,  80, YELLOW, 0.0f, ProjectileType::NORMAL, 0, 10.0f,  25, SpriteId::SUNFLOWER   },
+    { PlantType::CHERRY_BOMB, "Cherry Bomb", true,   50,   1, RED,    0.0f, ProjectileType::NORMAL, 0,  0.0f,   0, SpriteId::CHERRY_BOMB },
+    { PlantType::WALNUT,      "Wall-nut",    true,   75, 400, BROWN,  0.0f, ProjectileType::NORMAL, 0,  0.0f,   0, SpriteId::WALNUT      },
+    { PlantType::SHOVEL,      "Shovel",      false,   0,   0, BLANK,  0.0f, ProjectileType::NORMAL, 0,  0.0f,   0, SpriteId::SHOVEL      },
+    { PlantType::REPEATER,    "Repeater",    true,  200, 100, GREEN,  1.0f, ProjectileType::NORMAL, 2,  0.0f,   0, SpriteId::REPEATER    },
+    { PlantType::ICE_PEA,     "Ice Pea",     true,  150, 200, GREEN,  1.8f, ProjectileType::FROZEN, 1,  0.0f,   0, SpriteId::ICE_PEA     },
+    { PlantType::NONE,        "None",        false,   0,   0, BLANK,  0.0f, ProjectileType::NORMAL, 0,  0.0f,   0, SpriteId::COUNT       },
+};
+
+// Indexed by ZombieType
+constexpr ZombieArchetype ZOMBIE_ARCHETYPES[] = {
+    //  type                  name      hp   speed  bite  rate  score  color  sprite
+    { ZombieType::REGULAR, "Regular",  100, 20.0f, 20,  0.8f, 100,  RED,  SpriteId::REGULAR_ZOMBIE },
+    { ZombieType::JUMPING, "Jumping",  150, 25.0f, 20,  0.8f, 200,  BLUE, SpriteId::JUMPING_ZOMBIE },
+};
+
+// Indexed by ProjectileType
+constexpr ProjectileArchetype PROJECTILE_ARCHETYPES[] = {
+    //  type                     speed   dmg  w      h      effect                   sprite
+    { ProjectileType::NORMAL, 300.0f, 50, 20.0f, 10.0f, StatusEffectType::COUNT, SpriteId::PEA },
+    { ProjectileType::FROZEN, 300.0f, 50, 20.0f, 10.0f, StatusEffectType::SLOW,  SpriteId::PEA },
+};
+
+constexpr const PlantArchetype& GetPlantArchetype(PlantType type) { return PLANT_ARCHETYPES[(int)type]; }
+constexpr const ZombieArchetype& GetZombieArchetype(ZombieType type) { return ZOMBIE_ARCHETYPES[(int)type]; }
+constexpr const ProjectileArchetype& GetProjectileArchetype(ProjectileType type) { return PROJECTILE_ARCHETYPES[(int)type]; }
+
+//----------------------------------------------------------------------------------
+// Per-level Zombie Stats
+// Health grows 20% per level, speed by 2 px/s and bite damage by 5 per level.
+// Levels past MAX_SCALED_LEVEL keep the stats of the last row.
+//----------------------------------------------------------------------------------
+const int MAX_SCALED_LEVEL = 32;
+
+struct ZombieLevelStats {
+    int health;
+    float speed;
+    int damagePerBite;
+};
+
+struct ZombieLevelTable {
+    ZombieLevelStats levels[MAX_SCALED_LEVEL]; // levels[0] is level 1
+};
+
+constexpr ZombieLevelTable BuildZombieLevelTable(const ZombieArchetype& archetype) {
+    ZombieLevelTable table = {};
+    for (int i = 0; i < MAX_SCALED_LEVEL; ++i) {
+        int health = (int)(archetype.health * (1.0f + i * 0.2f));
+        float speed = archetype.speed + i * 2.0f;
+        table.levels[i].health = health < 1 ? 1 : health;
+        table.levels[i].speed = speed < 0.0f ? 0.0f : speed;
+        table.levels[i].damagePerBite = archetype.damagePerBite + i * 5;
+    }
+    return table;
+}
+
+// Indexed by ZombieType
+constexpr ZombieLevelTable ZOMBIE_LEVEL_TABLES[] = {
+    BuildZombieLevelTable(ZOMBIE_ARCHETYPES[(int)ZombieType::REGULAR]),
+    BuildZombieLevelTable(ZOMBIE_ARCHETYPES[(int)ZombieType::JUMPING]),
+};
+
+constexpr const ZombieLevelStats& GetZombieLevelStats(ZombieType type, int level) {
+    return ZOMBIE_LEVEL_TABLES[(int)type].levels[level < 1 ? 0 : (level > MAX_SCALED_LEVEL ? MAX_SCALED_LEVEL - 1 : level - 1)];
+}
+
+//----------------------------------------------------------------------------------
+// Compile-time Validation
+//----------------------------------------------------------------------------------
+constexpr bool ValidatePlantArchetypes() {
+    for (int i = 0; i < (int)(sizeof(PLANT_ARCHETYPES) / sizeof(PLANT_ARCHETYPES[0])); ++i) {
+        const PlantArchetype& a = PLANT_ARCHETYPES[i];
+        if ((int)a.type != i) return false;                                  // Row order matches the enum
+        if (a.placeable && (a.cost <= 0 || a.health <= 0)) return false;
+        if (a.projectilesPerShot > 0 && a.fireRate <= 0.0f) return false;    // Shooters need a fire rate
+        if (a.sunAmount > 0 && a.sunInterval <= 0.0f) return false;
+        if (a.placeable && a.sprite == SpriteId::COUNT) return false;       // Placeable plants need a sprite
+    }
+    return true;
+}
+
+constexpr bool ValidateZombieArchetypes() {
+    for (int i = 0; i < (int)(sizeof(ZOMBIE_ARCHETYPES) / sizeof(ZOMBIE_ARCHETYPES[0])); ++i) {
+        const ZombieArchetype& a = ZOMBIE_ARCHETYPES[i];
+        if ((int)a.type != i) return false;
+        if (a.health <= 0 || a.speed < 0.0f || a.biteRate <= 0.0f || a.damagePerBite < 0) return false;
+        if (ZOMBIE_LEVEL_TABLES[i].levels[0].health != a.health) return false; // Level 1 is unscaled
+    }
+    return true;
+}
+
+constexpr bool ValidateProjectileArchetypes() {
+    for (int i = 0; i < (int)(sizeof(PROJECTILE_ARCHETYPES) / sizeof(PROJECTILE_ARCHETYPES[0])); ++i) {
+        const ProjectileArchetype& a = PROJECTILE_ARCHETYPES[i];
+        if ((int)a.type != i) return false;
+        // ProjectileLanes keeps lanes sorted assuming every projectile moves at the same speed
+        if (a.speed != PROJECTILE_ARCHETYPES[0].speed || a.damage < 0) return false;
+    }
+    return true;
+}
+
+static_assert(sizeof(PLANT_ARCHETYPES) / sizeof(PLANT_ARCHETYPES[0]) == (int)PlantType::NONE + 1,
+              "PLANT_ARCHETYPES needs one row per PlantType");
+static_assert(sizeof(ZOMBIE_ARCHETYPES) / sizeof(ZOMBIE_ARCHETYPES[0]) == (int)ZombieType::JUMPING + 1,
+              "ZOMBIE_ARCHETYPES needs one row per ZombieType");
+static_assert(sizeof(ZOMBIE_LEVEL_TABLES) / sizeof(ZOMBIE_LEVEL_TABLES[0]) == sizeof(ZOMBIE_ARCHETYPES) / sizeof(ZOMBIE_ARCHETYPES[0]),
+              "ZOMBIE_LEVEL_TABLES needs one table per zombie archetype");
+static_assert(sizeof(PROJECTILE_ARCHETYPES) / sizeof(PROJECTILE_ARCHETYPES[0]) == (int)ProjectileType::FROZEN + 1,
+              "PROJECTILE_ARCHETYPES needs one row per ProjectileType");
+static_assert(ValidatePlantArchetypes(), "Invalid plant archetype");
+static_assert(ValidateZombieArchetypes(), "Invalid zombie archetype");
+static_assert(ValidateProjectileArchetypes(), "Invalid projectile archetype");
+
+#endif // ARCHETYPES_H
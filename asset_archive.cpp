@@ -0,0 +1,173 @@
+// asset_archive.cpp
+#include "asset_archive.h"
+#include "mapped_file.h"
+#include "logger.h"
+#include <algorithm> // For std::sort, std::lower_bound
+#include <cstdio>    // For fopen, fwrite
+#include <cstring>   // For strcmp, strncpy, memchr
+
+namespace {
+    MappedFile archiveFile;
+    const ArchiveEntry* entries = nullptr;   // Into archiveFile, sorted by name
+    uint32_t entryCount = 0;
+
+    bool EntryNameLess(const ArchiveEntry& entry, const char* name) {
+        return strcmp(entry.name, name) < 0;
+    }
+
+    // Header, index bounds and every entry's bounds and name
+    bool ValidateArchive(const unsigned char* data, size_t size) {
+        if (size < sizeof(ArchiveHeader)) return false;
+        const ArchiveHeader* header = (const ArchiveHeader*)data;
+        if (header->magic != ARCHIVE_MAGIC || header->version != ARCHIVE_VERSION) return false;
+        if (header->entryCount > (size - sizeof(ArchiveHeader)) / sizeof(ArchiveEntry)) return false;
+
+        const ArchiveEntry* index = (const ArchiveEntry*)(data + sizeof(ArchiveHeader));
+        for (uint32_t i = 0; i < header->entryCount; ++i) {
+            const ArchiveEntry& entry = index[i];
+            if (memchr(entry.name, 0, ARCHIVE_NAME_SIZE) == nullptr) return false;
+            if (entry.offset > size || entry.size > size - entry.offset) return false;
+            if (i > 0 && strcmp(index[i - 1].name, entry.name) >= 0) return false;
+        }
+        return true;
+    }
+
+    // The archive entry for 'fileName', warning if it was never packed
+    const ArchiveEntry* FindPacked(const char* fileName) {
+        const ArchiveEntry* entry = ArchiveFind(fileName);
+        if (!entry) GAME_LOG_WARNING(LogCategory::ASSETS, "%s is not in the asset archive", fileName);
+        return entry;
+    }
+}
+
+uint64_t ArchiveHash(const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+//----------------------------------------------------------------------------------
+// Archive Builder Implementation
+//----------------------------------------------------------------------------------
+bool ArchiveBuilder::Add(const char* name, ArchiveEntryType type, const unsigned char* data, int size) {
+    if (strlen(name) >= (size_t)ARCHIVE_NAME_SIZE) return false;
+    for (const PendingFile& file : files) {
+        if (file.name == name) return false;
+    }
+    files.push_back({ name, type, std::vector<unsigned char>(data, data + size) });
+    return true;
+}
+
+bool ArchiveBuilder::Write(const char* fileName) const {
+    std::vector<const PendingFile*> sorted;
+    for (const PendingFile& file : files) sorted.push_back(&file);
+    std::sort(sorted.begin(), sorted.end(), [](const PendingFile* a, const PendingFile* b) { return a->name < b->name; });
+
+    ArchiveHeader header = { ARCHIVE_MAGIC, ARCHIVE_VERSION, (uint32_t)sorted.size(), 0 };
+    std::vector<ArchiveEntry> index(sorted.size());
+    uint64_t offset = sizeof(ArchiveHeader) + sorted.size() * sizeof(ArchiveEntry);
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        offset = (offset + ARCHIVE_ALIGNMENT - 1) / ARCHIVE_ALIGNMENT * ARCHIVE_ALIGNMENT;
+        ArchiveEntry& entry = index[i];
+        memset(&entry, 0, sizeof(entry));
+        strncpy(entry.name, sorted[i]->name.c_str(), ARCHIVE_NAME_SIZE - 1);
+        entry.offset = offset;
+        entry.hash = ArchiveHash(sorted[i]->data.data(), sorted[i]->data.size());
+        entry.size = (uint32_t)sorted[i]->data.size();
+        entry.type = sorted[i]->type;
+        offset += entry.size;
+    }
+
+    FILE* file = fopen(fileName, "wb");
+    if (!file) return false;
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    if (!index.empty()) written = written && fwrite(index.data(), sizeof(ArchiveEntry), index.size(), file) == index.size();
+    const unsigned char padding[ARCHIVE_ALIGNMENT] = {};
+    long position = (long)(sizeof(ArchiveHeader) + index.size() * sizeof(ArchiveEntry));
+    for (size_t i = 0; written && i < sorted.size(); ++i) {
+        written = fwrite(padding, 1, (size_t)(index[i].offset - position), file) == (size_t)(index[i].offset - position);
+        written = written && fwrite(sorted[i]->data.data(), 1, index[i].size, file) == index[i].size;
+        position = (long)(index[i].offset + index[i].size);
+    }
+    return fclose(file) == 0 && written;
+}
+
+//----------------------------------------------------------------------------------
+// Runtime Archive Implementation
+//----------------------------------------------------------------------------------
+bool ArchiveOpen(const char* fileName) {
+    ArchiveClose();
+    if (!archiveFile.Open(fileName)) return false;
+    if (!ValidateArchive(archiveFile.GetData(), archiveFile.GetSize())) {
+        GAME_LOG_WARNING(LogCategory::ASSETS, "Asset archive %s is damaged or from another version, ignoring it", fileName);
+        archiveFile.Close();
+        return false;
+    }
+    entryCount = ((const ArchiveHeader*)archiveFile.GetData())->entryCount;
+    entries = (const ArchiveEntry*)(archiveFile.GetData() + sizeof(ArchiveHeader));
+    GAME_LOG_INFO(LogCategory::ASSETS, "Asset archive %s: %u files, %llu bytes mapped", fileName, entryCount,
+                  (unsigned long long)archiveFile.GetSize());
+    return true;
+}
+
+void ArchiveClose() {
+    archiveFile.Close();
+    entries = nullptr;
+    entryCount = 0;
+}
+
+bool ArchiveIsOpen() {
+    return archiveFile.IsOpen();
+}
+
+const ArchiveEntry* ArchiveFind(const char* name) {
+    const ArchiveEntry* end = entries + entryCount;
+    const ArchiveEntry* entry = std::lower_bound(entries, end, name, EntryNameLess);
+    if (entry == end || strcmp(entry->name, name) != 0) return nullptr;
+    return entry;
+}
+
+const unsigned char* ArchiveGetData(const ArchiveEntry& entry) {
+    return archiveFile.GetData() + entry.offset;
+}
+
+Image ArchiveLoadImage(const char* fileName) {
+    if (!ArchiveIsOpen()) return LoadImage(fileName);
+    const ArchiveEntry* entry = FindPacked(fileName);
+    if (!entry) return Image{};
+    return LoadImageFromMemory(GetFileExtension(fileName), ArchiveGetData(*entry), (int)entry->size);
+}
+
+Wave ArchiveLoadWave(const char* fileName) {
+    if (!ArchiveIsOpen()) return LoadWave(fileName);
+    const ArchiveEntry* entry = FindPacked(fileName);
+    if (!entry) return Wave{};
+    return LoadWaveFromMemory(GetFileExtension(fileName), ArchiveGetData(*entry), (int)entry->size);
+}
+
+// The stream keeps reading from the mapping while it plays
+Music ArchiveLoadMusicStream(const char* fileName) {
+    if (!ArchiveIsOpen()) return LoadMusicStream(fileName);
+    const ArchiveEntry* entry = FindPacked(fileName);
+    if (!entry) return Music{};
+    return LoadMusicStreamFromMemory(GetFileExtension(fileName), ArchiveGetData(*entry), (int)entry->size);
+}
+
+bool ArchiveLoadText(const char* fileName, std::string& outText) {
+    if (ArchiveIsOpen()) {
+        const ArchiveEntry* entry = ArchiveFind(fileName); // Optional files, no warning
+        if (!entry) return false;
+        outText.assign((const char*)ArchiveGetData(*entry), entry->size);
+        return true;
+    }
+    if (!FileExists(fileName)) return false;
+    char* text = LoadFileText(fileName);
+    if (!text) return false;
+    outText = text;
+    UnloadFileText(text);
+    return true;
+}
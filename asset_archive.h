@@ -0,0 +1,92 @@
+// asset_archive.h
+#ifndef ASSET_ARCHIVE_H
+#define ASSET_ARCHIVE_H
+
+#include "raylib.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------
+// Asset Archive
+// Every file the game loads is packed into one archive by tools/pack_assets,
+// which also fails the build when a listed file is missing. At startup the
+// archive is memory-mapped once. Images, sounds and the music stream are
+// created straight from the mapped bytes with raylib's Load*FromMemory: no
+// more opening files one by one, and no path lookups on disk.
+//
+// Layout, little-endian: an ArchiveHeader, then entryCount ArchiveEntry
+// records sorted by name, then the file contents, each aligned to
+// ARCHIVE_ALIGNMENT. Entries are named by the same paths the game used to
+// open, so the Archive* loaders below fall back to loose files when there is
+// no archive.
+//----------------------------------------------------------------------------------
+const char* const ASSET_ARCHIVE_PATH = "resources/assets.pak";
+const uint32_t ARCHIVE_MAGIC = 0x415A5650;  // "PVZA"
+const uint32_t ARCHIVE_VERSION = 1;
+const int ARCHIVE_NAME_SIZE = 64;           // Including the terminating zero
+const int ARCHIVE_ALIGNMENT = 16;
+
+enum class ArchiveEntryType : uint32_t {
+    IMAGE,
+    WAVE,
+    MUSIC,
+    TEXT
+};
+
+struct ArchiveHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+struct ArchiveEntry {
+    char name[ARCHIVE_NAME_SIZE];
+    uint64_t offset;          // From the start of the archive
+    uint64_t hash;            // ArchiveHash of the contents
+    uint32_t size;
+    ArchiveEntryType type;
+};
+
+static_assert(sizeof(ArchiveHeader) == 16, "ArchiveHeader is written as is");
+static_assert(sizeof(ArchiveEntry) == ARCHIVE_NAME_SIZE + 24, "ArchiveEntry is written as is");
+
+// 64-bit FNV-1a
+uint64_t ArchiveHash(const void* data, size_t size);
+
+// Packer side: collects files, then writes the archive
+class ArchiveBuilder {
+public:
+    // False if the name is too long or already added
+    bool Add(const char* name, ArchiveEntryType type, const unsigned char* data, int size);
+    bool Write(const char* fileName) const;
+
+    int GetCount() const { return (int)files.size(); }
+
+private:
+    struct PendingFile {
+        std::string name;
+        ArchiveEntryType type;
+        std::vector<unsigned char> data;
+    };
+
+    std::vector<PendingFile> files;
+};
+
+// Runtime side, one archive for the whole game. Entries are only read after
+// ArchiveOpen, so any thread may load from it.
+bool ArchiveOpen(const char* fileName);     // False if missing or malformed; loads then read loose files
+void ArchiveClose();                        // After every music stream using it is unloaded
+bool ArchiveIsOpen();
+const ArchiveEntry* ArchiveFind(const char* name);
+// Contents of an entry, pointing into the mapping
+const unsigned char* ArchiveGetData(const ArchiveEntry& entry);
+
+// From the archive when one is open, from disk otherwise
+Image ArchiveLoadImage(const char* fileName);
+Wave ArchiveLoadWave(const char* fileName);
+Music ArchiveLoadMusicStream(const char* fileName);
+bool ArchiveLoadText(const char* fileName, std::string& outText);
+
+#endif // ASSET_ARCHIVE_H
@@ -0,0 +1,103 @@
+// asset_loader.cpp
+#include "asset_loader.h"
+#include "logger.h"
+#include "asset_archive.h"
+#include "texture_cache.h"
+#include <algorithm> // For std::min, std::max
+
+namespace {
+    const char* KIND_NAMES[] = { "image", "wave", "task" };
+}
+
+//----------------------------------------------------------------------------------
+// Asset Loader Implementation
+//----------------------------------------------------------------------------------
+AssetLoader::AssetLoader() : nextAsset(0), finishedCount(0) {}
+
+AssetLoader::~AssetLoader() {
+    Wait();
+    for (Asset& asset : assets) {
+        if (asset.kind == AssetKind::IMAGE) UnloadImage(asset.image);
+        else if (asset.kind == AssetKind::WAVE) UnloadWave(asset.wave);
+    }
+}
+
+AssetId AssetLoader::AddImage(const char* fileName, int width, int height) {
+    assets.push_back({ AssetKind::IMAGE, fileName, width, height, nullptr, Image{}, Wave{}, false, 0.0f });
+    return (AssetId)assets.size() - 1;
+}
+
+AssetId AssetLoader::AddWave(const char* fileName) {
+    assets.push_back({ AssetKind::WAVE, fileName, 0, 0, nullptr, Image{}, Wave{}, false, 0.0f });
+    return (AssetId)assets.size() - 1;
+}
+
+AssetId AssetLoader::AddTask(const char* name, std::function<bool()> task) {
+    assets.push_back({ AssetKind::TASK, name, 0, 0, std::move(task), Image{}, Wave{}, false, 0.0f });
+    return (AssetId)assets.size() - 1;
+}
+
+void AssetLoader::Start(int threads) {
+    if (threads < 0) threads = std::max(1, (int)std::thread::hardware_concurrency());
+    threads = std::min(threads, (int)assets.size());
+    startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < threads; ++i) workers.emplace_back(&AssetLoader::WorkerLoop, this);
+}
+
+void AssetLoader::Wait() {
+    if (workers.empty()) return;
+    for (std::thread& worker : workers) worker.join();
+
+    const Asset* slowest = nullptr;
+    for (const Asset& asset : assets) {
+        if (!slowest || asset.decodeMs > slowest->decodeMs) slowest = &asset;
+    }
+    float totalMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    GAME_LOG_INFO(LogCategory::ASSETS, "Decoded %d assets in %.1f ms on %d threads, slowest %s (%.1f ms)",
+                  (int)assets.size(), totalMs, (int)workers.size(), slowest->name.c_str(), slowest->decodeMs);
+    workers.clear();
+}
+
+Image AssetLoader::TakeImage(AssetId id) {
+    Image image = assets[id].image;
+    assets[id].image = Image{};
+    return image;
+}
+
+Wave AssetLoader::TakeWave(AssetId id) {
+    Wave wave = assets[id].wave;
+    assets[id].wave = Wave{};
+    return wave;
+}
+
+// Takes assets in queued order until none are left
+void AssetLoader::WorkerLoop() {
+    for (int index = nextAsset.fetch_add(1); index < (int)assets.size(); index = nextAsset.fetch_add(1)) {
+        Decode(assets[index]);
+        finishedCount.fetch_add(1);
+    }
+}
+
+void AssetLoader::Decode(Asset& asset) {
+    auto start = std::chrono::steady_clock::now();
+    switch (asset.kind) {
+        case AssetKind::IMAGE:
+            asset.image = TextureCacheLoad(asset.name.c_str(), asset.width, asset.height);
+            asset.succeeded = IsImageValid(asset.image);
+            break;
+        case AssetKind::WAVE:
+            asset.wave = ArchiveLoadWave(asset.name.c_str());
+            asset.succeeded = IsWaveValid(asset.wave);
+            break;
+        case AssetKind::TASK:
+            asset.succeeded = asset.task();
+            break;
+    }
+    asset.decodeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (asset.succeeded) {
+        GAME_LOG_INFO(LogCategory::ASSETS, "Decoded %s %s in %.1f ms", KIND_NAMES[(int)asset.kind], asset.name.c_str(), asset.decodeMs);
+    } else {
+        GAME_LOG_WARNING(LogCategory::ASSETS, "Could not load %s %s", KIND_NAMES[(int)asset.kind], asset.name.c_str());
+    }
+}
@@ -0,0 +1,83 @@
+// asset_loader.h
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include "raylib.h"
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+//----------------------------------------------------------------------------------
+// Asset Loader
+// Decoding PNGs and MP3s is what made startup slow, and none of it needs the
+// GPU or the audio device. Assets are queued here, and a few loader threads
+// decode them into CPU-side Images and Waves while the main thread keeps
+// drawing a progress bar. Afterwards the main thread only uploads: textures
+// from the Images, sounds from the Waves. Loading takes about as long as the
+// slowest single asset instead of the sum of all of them.
+//
+// A task is any other CPU-only job, e.g. importing or packing the atlas. Files
+// come from the asset archive when one is open, images through the texture
+// cache. Every asset's decode time is logged.
+//----------------------------------------------------------------------------------
+typedef int AssetId;
+
+class AssetLoader {
+public:
+    AssetLoader();
+    ~AssetLoader(); // Waits for the loader threads
+
+    // Queue before Start
+    // Resized to width x height, the size it is drawn at; 0 keeps the file's own size
+    AssetId AddImage(const char* fileName, int width = 0, int height = 0);
+    AssetId AddWave(const char* fileName);
+    // 'task' runs on a loader thread and returns false on failure
+    AssetId AddTask(const char* name, std::function<bool()> task);
+
+    // 'threads' loader threads, -1 for one per hardware thread; never more than there are assets
+    void Start(int threads = -1);
+    // Blocks until every asset is decoded
+    void Wait();
+
+    int GetCount() const { return (int)assets.size(); }
+    int GetFinishedCount() const { return finishedCount.load(); }
+    bool IsFinished() const { return GetFinishedCount() == GetCount(); }
+    float GetProgress() const { return assets.empty() ? 1.0f : (float)GetFinishedCount() / assets.size(); }
+
+    // After Wait. Ownership passes to the caller; an asset that failed to decode is empty.
+    Image TakeImage(AssetId id);
+    Wave TakeWave(AssetId id);
+    bool Succeeded(AssetId id) const { return assets[id].succeeded; }
+
+private:
+    enum class AssetKind {
+        IMAGE,
+        WAVE,
+        TASK
+    };
+
+    struct Asset {
+        AssetKind kind;
+        std::string name;                // File name, or the task's name
+        int width, height;               // Image size, 0 for the file's own
+        std::function<bool()> task;
+        Image image;
+        Wave wave;
+        bool succeeded;
+        float decodeMs;
+    };
+
+    void WorkerLoop();
+    void Decode(Asset& asset);
+
+    std::vector<Asset> assets;
+    std::vector<std::thread> workers;
+    std::atomic<int> nextAsset;
+    std::atomic<int> finishedCount;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+#endif // ASSET_LOADER_H
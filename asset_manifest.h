@@ -0,0 +1,49 @@
+// asset_manifest.h
+#ifndef ASSET_MANIFEST_H
+#define ASSET_MANIFEST_H
+
+#include "sim_events.h"     // For SoundCue
+#include "texture_atlas.h"  // For SPRITE_SOURCES, ATLAS_TABLE_PATH
+
+//----------------------------------------------------------------------------------
+// Asset Manifest
+// Every file the game loads, besides the sprites in SPRITE_SOURCES. The game
+// loads them by these names, and tools/pack_assets packs exactly these files
+// into the asset archive. A required file that is missing fails the pack; an
+// optional one is reported and the game runs without it.
+//----------------------------------------------------------------------------------
+// Full-screen images, not atlased
+enum class BackgroundId {
+    GRASS,
+    MAIN_MENU,
+    LEVEL_UP,
+    COUNT
+};
+
+// Indexed by BackgroundId
+const char* const BACKGROUND_SOURCES[(int)BackgroundId::COUNT] = {
+    "resources/grass_background.png",
+    "resources/main_menu_background.png",
+    "resources/levelup.png"
+};
+
+// Every sound is a cue with a small voice pool, maxVoices caps its overlapping copies
+struct SoundSource {
+    SoundCue cue;
+    const char* fileName;
+    int maxVoices;
+};
+
+const SoundSource SOUND_SOURCES[] = {
+    { SoundCue::SHOOT,     "resources/shoot.mp3",     4 },
+    { SoundCue::HIT,       "resources/hit.mp3",       4 },
+    { SoundCue::GAME_OVER, "resources/gameover.mp3",  1 },
+    { SoundCue::EXPLOSION, "resources/explosion.mp3", 2 },
+    { SoundCue::LAWNMOWER, "resources/lawnmower.mp3", 3 },
+    { SoundCue::DIG,       "resources/dig.mp3",       1 }
+};
+const int SOUND_SOURCE_COUNT = sizeof(SOUND_SOURCES) / sizeof(SOUND_SOURCES[0]);
+
+const char* const MUSIC_SOURCE = "resources/game_music.mp3"; // Streamed while playing
+
+#endif // ASSET_MANIFEST_H
@@ -0,0 +1,95 @@
+// audio_cues.cpp
+#include "audio_cues.h"
+
+//----------------------------------------------------------------------------------
+// Audio Cues Implementation
+//----------------------------------------------------------------------------------
+AudioCues::AudioCues()
+    : frameStats(), totalStats()
+{
+    for (CuePool& pool : pools) {
+        pool.nextVoice = 0;
+        pool.pendingRequests = 0;
+    }
+}
+
+void AudioCues::Load(SoundCue cue, const Wave& wave, int maxVoices) {
+    CuePool& pool = pools[(int)cue];
+    if (!pool.voices.empty()) return; // Already loaded
+
+    Sound source = IsWaveValid(wave) ? LoadSoundFromWave(wave) : Sound{};
+    pool.voices.push_back(source);
+    if (!IsSoundValid(source)) return; // Missing file: keep the empty sound, playing it is a no-op
+
+    // Aliases share the sample data, each one is an extra voice that can play alongside the others
+    for (int i = 1; i < maxVoices; ++i) {
+        pool.voices.push_back(LoadSoundAlias(source));
+    }
+}
+
+void AudioCues::Unload() {
+    for (CuePool& pool : pools) {
+        // Aliases first, the source owns the samples they point to
+        for (size_t i = 1; i < pool.voices.size(); ++i) {
+            UnloadSoundAlias(pool.voices[i]);
+        }
+        if (!pool.voices.empty()) UnloadSound(pool.voices[0]);
+        pool.voices.clear();
+        pool.nextVoice = 0;
+        pool.pendingRequests = 0;
+    }
+}
+
+void AudioCues::Request(SoundCue cue) {
+    pools[(int)cue].pendingRequests++;
+}
+
+void AudioCues::Flush() {
+    frameStats = AudioCueStats();
+
+    for (CuePool& pool : pools) {
+        if (pool.pendingRequests == 0) continue;
+        if (pool.voices.empty()) { // Never loaded, nothing to play
+            pool.pendingRequests = 0;
+            continue;
+        }
+
+        frameStats.requested += pool.pendingRequests;
+        frameStats.deduplicated += pool.pendingRequests - 1;
+        pool.pendingRequests = 0;
+
+        // Next voice that is not playing, starting after the last one used
+        int voiceCount = (int)pool.voices.size();
+        int freeVoice = -1;
+        for (int k = 0; k < voiceCount; ++k) {
+            int voice = (pool.nextVoice + k) % voiceCount;
+            if (!IsSoundPlaying(pool.voices[voice])) {
+                freeVoice = voice;
+                break;
+            }
+        }
+
+        if (freeVoice < 0) {
+            frameStats.voiceLimited++; // Every voice busy: the cue is already loud enough
+            continue;
+        }
+        PlaySound(pool.voices[freeVoice]);
+        pool.nextVoice = (freeVoice + 1) % voiceCount;
+        frameStats.played++;
+    }
+
+    totalStats.requested += frameStats.requested;
+    totalStats.played += frameStats.played;
+    totalStats.deduplicated += frameStats.deduplicated;
+    totalStats.voiceLimited += frameStats.voiceLimited;
+}
+
+int AudioCues::GetActiveVoiceCount() const {
+    int active = 0;
+    for (const CuePool& pool : pools) {
+        for (const Sound& voice : pool.voices) {
+            if (IsSoundPlaying(voice)) ++active;
+        }
+    }
+    return active;
+}
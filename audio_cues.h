@@ -0,0 +1,54 @@
+// audio_cues.h
+#ifndef AUDIO_CUES_H
+#define AUDIO_CUES_H
+
+#include "raylib.h"
+#include <vector>
+#include "sim_events.h" // For SoundCue
+
+//----------------------------------------------------------------------------------
+// Audio Cues
+// The simulation reports sound cues; this turns them into actual playback once
+// per frame. Requests for the same cue within a frame collapse into one play,
+// so twenty peas hitting at once restart nothing twenty times. Each cue owns a
+// small pool of voices (the loaded Sound plus LoadSoundAlias copies sharing its
+// samples), which also caps how many copies of a cue can overlap.
+//----------------------------------------------------------------------------------
+struct AudioCueStats {
+    int requested;    // Cues reported by the simulation
+    int played;       // Voices actually started
+    int deduplicated; // Requests merged into another request of the same frame
+    int voiceLimited; // Requests dropped because every voice of the cue was busy
+};
+
+class AudioCues {
+public:
+    AudioCues();
+
+    // Creates the sound from a decoded wave (the caller still owns it) and maxVoices - 1
+    // aliases of it, call after InitAudioDevice
+    void Load(SoundCue cue, const Wave& wave, int maxVoices);
+    void Unload();
+
+    // Queues a cue for this frame, cheap to call any number of times
+    void Request(SoundCue cue);
+    // Starts at most one voice per requested cue, call once per frame
+    void Flush();
+
+    const AudioCueStats& GetFrameStats() const { return frameStats; } // Last flushed frame
+    const AudioCueStats& GetTotalStats() const { return totalStats; }
+    int GetActiveVoiceCount() const;
+
+private:
+    struct CuePool {
+        std::vector<Sound> voices; // voices[0] owns the samples, the others are aliases
+        int nextVoice;             // Round-robin start for the free voice search
+        int pendingRequests;       // Requests since the last Flush
+    };
+
+    CuePool pools[(int)SoundCue::COUNT];
+    AudioCueStats frameStats;
+    AudioCueStats totalStats;
+};
+
+#endif // AUDIO_CUES_H
@@ -0,0 +1,176 @@
+// broadphase.cpp
+#include "broadphase.h"
+#include <algorithm> // For std::lower_bound, std::max
+
+namespace {
+    bool IntervalsOverlap(const BroadphaseBounds& a, const BroadphaseBounds& b) {
+        // Strict on x, like CheckCollisionRecs: touching edges are not a contact
+        return a.minX < b.maxX && b.minX < a.maxX;
+    }
+
+    bool LanesOverlap(const BroadphaseBounds& a, const BroadphaseBounds& b) {
+        return a.minLane <= b.maxLane && b.minLane <= a.maxLane;
+    }
+
+    // Tests 'proxy' against the active list, dropping the entries that ended before it starts.
+    // The sweep visits proxies by increasing minX, so those can't overlap anything later either.
+    void SweepAgainst(const BroadphaseProxy& proxy, std::vector<const BroadphaseProxy*>& active,
+                      bool proxyIsA, std::vector<BroadphasePair>& out) {
+        for (size_t k = 0; k < active.size();) {
+            const BroadphaseProxy* other = active[k];
+            if (other->bounds.maxX <= proxy.bounds.minX) {
+                active[k] = active.back();
+                active.pop_back();
+                continue;
+            }
+            if (LanesOverlap(proxy.bounds, other->bounds)) {
+                if (proxyIsA) out.push_back({ proxy.owner, other->owner });
+                else out.push_back({ other->owner, proxy.owner });
+            }
+            ++k;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Broadphase Implementation
+//----------------------------------------------------------------------------------
+Broadphase::Broadphase()
+    : lastSwapCount(0)
+{
+    for (auto& list : kinds) {
+        list.boundsOf = nullptr;
+        list.maxWidth = 0.0f;
+    }
+}
+
+void Broadphase::SetBoundsFunction(BroadphaseKind kind, BroadphaseBoundsFunction function) {
+    kinds[(int)kind].boundsOf = function;
+}
+
+void Broadphase::SetSlot(KindList& list, size_t index) {
+    list.slotOf[list.proxies[index].id] = (int)index;
+}
+
+int Broadphase::Add(BroadphaseKind kind, void* owner) {
+    KindList& list = kinds[(int)kind];
+
+    int id;
+    if (!list.freeIds.empty()) {
+        id = list.freeIds.back();
+        list.freeIds.pop_back();
+    } else {
+        id = (int)list.slotOf.size();
+        list.slotOf.push_back(-1);
+    }
+
+    BroadphaseProxy proxy;
+    proxy.bounds = list.boundsOf(owner);
+    proxy.owner = owner;
+    proxy.id = id;
+    list.proxies.push_back(proxy);
+    SetSlot(list, list.proxies.size() - 1);
+    list.maxWidth = std::max(list.maxWidth, proxy.bounds.maxX - proxy.bounds.minX);
+    return id;
+}
+
+void Broadphase::Remove(BroadphaseKind kind, int id) {
+    KindList& list = kinds[(int)kind];
+    if (id < 0 || id >= (int)list.slotOf.size() || list.slotOf[id] < 0) return;
+    list.proxies[list.slotOf[id]].owner = nullptr;
+}
+
+void Broadphase::Clear() {
+    for (auto& list : kinds) {
+        list.proxies.clear();
+        list.slotOf.clear();
+        list.freeIds.clear();
+        list.maxWidth = 0.0f;
+    }
+}
+
+void Broadphase::Update() {
+    lastSwapCount = 0;
+
+    for (auto& list : kinds) {
+        std::vector<BroadphaseProxy>& proxies = list.proxies;
+
+        // Drop removed proxies (order preserving) and refresh the others from their owners
+        size_t kept = 0;
+        list.maxWidth = 0.0f;
+        for (size_t i = 0; i < proxies.size(); ++i) {
+            if (!proxies[i].owner) {
+                list.slotOf[proxies[i].id] = -1;
+                list.freeIds.push_back(proxies[i].id);
+                continue;
+            }
+            proxies[kept] = proxies[i];
+            proxies[kept].bounds = list.boundsOf(proxies[kept].owner);
+            list.maxWidth = std::max(list.maxWidth, proxies[kept].bounds.maxX - proxies[kept].bounds.minX);
+            SetSlot(list, kept);
+            ++kept;
+        }
+        proxies.resize(kept);
+
+        // Insertion sort, close to linear because the previous order is almost still right
+        for (size_t i = 1; i < proxies.size(); ++i) {
+            for (size_t j = i; j > 0 && proxies[j - 1].bounds.minX > proxies[j].bounds.minX; --j) {
+                std::swap(proxies[j - 1], proxies[j]);
+                SetSlot(list, j - 1);
+                SetSlot(list, j);
+                ++lastSwapCount;
+            }
+        }
+    }
+}
+
+void Broadphase::CollectPairs(BroadphaseKind kindA, BroadphaseKind kindB, std::vector<BroadphasePair>& out) const {
+    const std::vector<BroadphaseProxy>& listA = kinds[(int)kindA].proxies;
+    const std::vector<BroadphaseProxy>& listB = kinds[(int)kindB].proxies;
+    activeA.clear();
+    activeB.clear();
+
+    if (kindA == kindB) {
+        for (const BroadphaseProxy& proxy : listA) {
+            if (!proxy.owner) continue;
+            SweepAgainst(proxy, activeA, true, out);
+            activeA.push_back(&proxy);
+        }
+        return;
+    }
+
+    // Merge both sorted lists by minX, each proxy is only tested against the other kind
+    size_t i = 0, j = 0;
+    while (i < listA.size() || j < listB.size()) {
+        bool takeA = j >= listB.size() || (i < listA.size() && listA[i].bounds.minX <= listB[j].bounds.minX);
+        if (takeA) {
+            const BroadphaseProxy& proxy = listA[i++];
+            if (!proxy.owner) continue;
+            SweepAgainst(proxy, activeB, true, out);
+            activeA.push_back(&proxy);
+        } else {
+            const BroadphaseProxy& proxy = listB[j++];
+            if (!proxy.owner) continue;
+            SweepAgainst(proxy, activeA, false, out);
+            activeB.push_back(&proxy);
+        }
+    }
+}
+
+void Broadphase::Query(BroadphaseKind kind, const BroadphaseBounds& area, std::vector<void*>& out) const {
+    const KindList& list = kinds[(int)kind];
+
+    // Nothing wider than maxWidth can reach area.minX when it starts before area.minX - maxWidth
+    auto it = std::lower_bound(list.proxies.begin(), list.proxies.end(), area.minX - list.maxWidth,
+                               [](const BroadphaseProxy& p, float x) { return p.bounds.minX < x; });
+
+    for (; it != list.proxies.end() && it->bounds.minX < area.maxX; ++it) {
+        if (it->owner && IntervalsOverlap(it->bounds, area) && LanesOverlap(it->bounds, area)) {
+            out.push_back(it->owner);
+        }
+    }
+}
+
+size_t Broadphase::GetProxyCount(BroadphaseKind kind) const {
+    return kinds[(int)kind].proxies.size();
+}
@@ -0,0 +1,89 @@
+// broadphase.h
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <vector>
+#include <cstddef> // For size_t
+
+//----------------------------------------------------------------------------------
+// Broadphase (sort and sweep)
+// Every registered entity is a proxy with an x interval and a lane span.
+// Proxies are kept sorted by their left edge per entity kind. Entities barely
+// move between ticks, so the order is repaired with an insertion sort that
+// costs almost nothing when nothing overtook anything.
+//
+// Lanes replace the old hard-coded "same row" checks: two proxies interact
+// when their x intervals and lane spans overlap. An entity that crosses lanes
+// (a zombie changing rows, a plant covering two rows) only has to report a
+// wider lane span from its bounds function.
+//----------------------------------------------------------------------------------
+enum class BroadphaseKind {
+    PLANT,
+    ZOMBIE,
+    MOWER,
+    COUNT
+};
+
+struct BroadphaseBounds {
+    float minX;
+    float maxX;
+    int minLane;
+    int maxLane;
+};
+
+// Reads the current bounds of an owner, one function per kind
+typedef BroadphaseBounds (*BroadphaseBoundsFunction)(const void* owner);
+
+struct BroadphaseProxy {
+    BroadphaseBounds bounds;
+    void* owner; // nullptr once removed, dropped on the next Update
+    int id;
+};
+
+struct BroadphasePair {
+    void* a; // Owner of the first kind passed to CollectPairs
+    void* b; // Owner of the second kind
+};
+
+class Broadphase {
+public:
+    Broadphase();
+
+    void SetBoundsFunction(BroadphaseKind kind, BroadphaseBoundsFunction function);
+
+    // Returns the proxy id, to be kept by the owner for Remove.
+    // New proxies are sorted into place by the next Update.
+    int Add(BroadphaseKind kind, void* owner);
+    // Hides the proxy from queries immediately, call before the owner is destroyed
+    void Remove(BroadphaseKind kind, int id);
+    void Clear();
+
+    // Refreshes every bounds from its owner and restores the x order
+    void Update();
+
+    // Appends every overlapping (kindA, kindB) pair. Works for kindA == kindB too.
+    void CollectPairs(BroadphaseKind kindA, BroadphaseKind kindB, std::vector<BroadphasePair>& out) const;
+    // Appends the owners of 'kind' overlapping 'area'
+    void Query(BroadphaseKind kind, const BroadphaseBounds& area, std::vector<void*>& out) const;
+
+    size_t GetProxyCount(BroadphaseKind kind) const;
+    int GetLastSwapCount() const { return lastSwapCount; }
+
+private:
+    struct KindList {
+        std::vector<BroadphaseProxy> proxies; // Sorted by bounds.minX after Update
+        std::vector<int> slotOf;              // Proxy id -> index in proxies, -1 if free
+        std::vector<int> freeIds;
+        BroadphaseBoundsFunction boundsOf;
+        float maxWidth;                       // Widest proxy, bounds the backwards search in Query
+    };
+
+    void SetSlot(KindList& list, size_t index);
+
+    KindList kinds[(int)BroadphaseKind::COUNT];
+    mutable std::vector<const BroadphaseProxy*> activeA; // Sweep scratch, kept to avoid reallocating
+    mutable std::vector<const BroadphaseProxy*> activeB;
+    int lastSwapCount;
+};
+
+#endif // BROADPHASE_H
@@ -0,0 +1,125 @@
+// contact_scheduler.cpp
+#include "contact_scheduler.h"
+#include "zombie.h"
+#include "plant.h"
+#include <algorithm> // For std::push_heap, std::pop_heap, std::make_heap
+#include <cfloat>    // For FLT_MAX
+
+namespace {
+    // std heap functions build a max-heap, invert the comparison to get the earliest event on top
+    bool LaterEvent(const ContactEvent& a, const ContactEvent& b) {
+        return a.time > b.time;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Contact Scheduler Implementation
+//----------------------------------------------------------------------------------
+ContactScheduler::ContactScheduler(const Broadphase& broadphase)
+    : clock(0.0), nextTicket(1), broadphase(broadphase)
+{
+}
+
+void ContactScheduler::Reset() {
+    clock = 0.0;
+    events.clear();
+    pending.clear();
+    addedPlants.clear();
+}
+
+void ContactScheduler::Advance(float deltaTime) {
+    clock += deltaTime;
+
+    // Wake every zombie still to the right of a newly placed plant, in the lanes it covers
+    for (const BroadphaseBounds& plant : addedPlants) {
+        queryResults.clear();
+        broadphase.Query(BroadphaseKind::ZOMBIE, { plant.minX, FLT_MAX, plant.minLane, plant.maxLane }, queryResults);
+        for (void* owner : queryResults) {
+            static_cast<Zombie*>(owner)->RequestContactCheck();
+        }
+    }
+    addedPlants.clear();
+
+    while (!events.empty() && events.front().time <= clock) {
+        unsigned long long ticket = events.front().ticket;
+        std::pop_heap(events.begin(), events.end(), LaterEvent);
+        events.pop_back();
+
+        auto it = pending.find(ticket);
+        if (it == pending.end()) continue; // Stale: zombie was woken early, rescheduled or removed
+
+        it->second->contactTicket = 0;
+        it->second->RequestContactCheck();
+        pending.erase(it);
+    }
+}
+
+Plant* ContactScheduler::Resolve(Zombie* zombie) {
+    if (!zombie->active || !zombie->contactCheckPending) return nullptr;
+
+    queryResults.clear();
+    broadphase.Query(BroadphaseKind::PLANT, zombie->GetBounds(), queryResults);
+    for (void* owner : queryResults) {
+        Plant* plant = static_cast<Plant*>(owner);
+        if (plant->active) {
+            return plant; // Stays awake while it is eating (or jumping over) a plant
+        }
+    }
+
+    Sleep(zombie);
+    return nullptr;
+}
+
+void ContactScheduler::Sleep(Zombie* zombie) {
+    zombie->contactCheckPending = false;
+    if (zombie->contactTicket != 0) {
+        pending.erase(zombie->contactTicket);
+        zombie->contactTicket = 0;
+    }
+
+    if (zombie->speed <= 0.0f) return;
+
+    // Nearest plant ahead: the one whose right edge is closest to the zombie's left edge.
+    // Plants already behind the zombie (fully to its right) can't be reached anymore.
+    BroadphaseBounds bounds = zombie->GetBounds();
+    queryResults.clear();
+    broadphase.Query(BroadphaseKind::PLANT, { -FLT_MAX, bounds.maxX, bounds.minLane, bounds.maxLane }, queryResults);
+
+    float nearestGap = -1.0f;
+    for (void* owner : queryResults) {
+        const Plant* plant = static_cast<const Plant*>(owner);
+        if (!plant->active) continue;
+        float gap = bounds.minX - (plant->rect.x + plant->rect.width);
+        if (gap < 0.0f) gap = 0.0f;
+        if (nearestGap < 0.0f || gap < nearestGap) nearestGap = gap;
+    }
+    if (nearestGap < 0.0f) return; // Nothing left to reach, sleeps until the lane changes
+
+    unsigned long long ticket = nextTicket++;
+    zombie->contactTicket = ticket;
+    pending[ticket] = zombie;
+
+    events.push_back({ clock + nearestGap / zombie->speed, ticket });
+    std::push_heap(events.begin(), events.end(), LaterEvent);
+
+    // Early wake-ups leave stale events behind, drop them once they dominate the heap
+    if (events.size() > 2 * pending.size() + 64) CompactEvents();
+}
+
+void ContactScheduler::CompactEvents() {
+    events.erase(std::remove_if(events.begin(), events.end(),
+                                [this](const ContactEvent& e) { return pending.find(e.ticket) == pending.end(); }),
+                 events.end());
+    std::make_heap(events.begin(), events.end(), LaterEvent);
+}
+
+void ContactScheduler::OnPlantAdded(const Plant* plant) {
+    addedPlants.push_back(plant->GetBounds());
+}
+
+void ContactScheduler::Forget(Zombie* zombie) {
+    if (zombie->contactTicket != 0) {
+        pending.erase(zombie->contactTicket);
+        zombie->contactTicket = 0;
+    }
+}
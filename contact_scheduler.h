@@ -0,0 +1,67 @@
+// contact_scheduler.h
+#ifndef CONTACT_SCHEDULER_H
+#define CONTACT_SCHEDULER_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstddef> // For size_t
+#include "broadphase.h"
+
+// Forward declarations, the scheduler only stores pointers
+class Zombie;
+class Plant;
+
+//----------------------------------------------------------------------------------
+// Contact Scheduler
+// A walking zombie reaches the next plant in its lane at a time fully determined
+// by its x, its speed and the plant's position. Instead of testing every plant
+// every frame, the scheduler predicts that time and keeps the zombie asleep
+// until then. Zombies are woken early when something relevant changes:
+// spawn, slow (see Zombie::RequestContactCheck) or a plant placed in the lane.
+// Zombies touching a plant stay awake and are resolved every tick.
+// Plants and lanes are looked up through the Broadphase, which must be
+// updated before Advance. Removed plants need no notification: zombies
+// predicted to reach one wake up, find nothing and go back to sleep.
+//----------------------------------------------------------------------------------
+struct ContactEvent {
+    double time;
+    unsigned long long ticket; // Matches Zombie::contactTicket while the event is still valid
+};
+
+class ContactScheduler {
+public:
+    explicit ContactScheduler(const Broadphase& broadphase);
+
+    void Reset();
+
+    // Advances the clock and wakes every zombie whose predicted contact is due,
+    // or that has a plant placed ahead of it since the last tick
+    void Advance(float deltaTime);
+
+    // Returns the plant the zombie is touching this tick, or nullptr.
+    // Asleep zombies return immediately, awake ones without contact go back to sleep.
+    Plant* Resolve(Zombie* zombie);
+
+    // A new plant can be nearer than what sleeping zombies were predicted to reach.
+    // Handled in the next Advance, once the plant is sorted into the broadphase.
+    void OnPlantAdded(const Plant* plant);
+
+    // Drops the zombie's pending event, call before the zombie is destroyed
+    void Forget(Zombie* zombie);
+
+    size_t GetSleepingCount() const { return pending.size(); }
+
+private:
+    void Sleep(Zombie* zombie);
+    void CompactEvents();
+
+    double clock;
+    unsigned long long nextTicket;
+    std::vector<ContactEvent> events;                     // Min-heap on time, may hold stale tickets
+    std::unordered_map<unsigned long long, Zombie*> pending; // Live tickets only
+    const Broadphase& broadphase;
+    std::vector<BroadphaseBounds> addedPlants; // Footprints of plants placed since the last Advance
+    std::vector<void*> queryResults;           // Scratch buffer for broadphase queries
+};
+
+#endif // CONTACT_SCHEDULER_H
@@ -21,60 +21,44 @@ extern const int GRID_START_Y; // Y-coordinate where the grid starts
 // Cherry Bomb specific: time until it explodes after placement
 const float FUSE_DURATION = 1.5f; // Seconds
 
+// Shooters with nothing in their lane look again after this long instead of every frame
+const float SHOOTER_IDLE_RECHECK_INTERVAL = 0.1f; // Seconds
+
+// Resolution of the gameplay timer wheel, every deadline is rounded up to a whole tick
+const float TIMER_WHEEL_TICK = 1.0f / 120.0f; // Seconds
+
+// The simulation thread advances the game in fixed steps of this length, whatever the frame rate
+const float SIM_TICK_INTERVAL = 1.0f / 120.0f; // Seconds
+// Steps run back to back after a stall before the simulation gives up catching up
+const int SIM_MAX_STEPS_PER_WAKE = 8;
+
+// Zombies right of the screen are dormant: they only walk, one step of this length at a
+// time, and wake up (animation, contacts, collisions) when the next step would bring them in
+const float SIM_LOD_COARSE_INTERVAL = 0.25f; // Seconds
+
 //----------------------------------------------------------------------------------
 // Zombie Animation and Behavior Constants
 // IMPORTANT: Adjust these values to match your actual sprite sheets and desired game balance.
 //----------------------------------------------------------------------------------
 
-// Base Zombie Stats (can be overridden by derived classes or scaled by level)
-// These are default values if not specified otherwise for a derived type.
-const int ZOMBIE_HEALTH = 100;              // Base health for a generic zombie
-const float ZOMBIE_SPEED = 20.0f;           // Base movement speed (pixels per second)
-const float ZOMBIE_DAMAGE_PER_SECOND = 10.0f; // Damage plants take per second (alternative to bite system if used)
-
-// Zombie Attack/Bite System specific constants
-const int ZOMBIE_DAMAGE_PER_BITE = 20;      // Damage dealt per single bite by a zombie
-const float ZOMBIE_BITE_RATE = 0.8f;        // Seconds between each bite action
-
-// Regular Zombie specific stats and animation properties
-const int REGULAR_ZOMBIE_HEALTH = 100;      // Health specific to RegularZombie
-const float REGULAR_ZOMBIE_SPEED = 20.0f;   // Speed specific to RegularZombie
+// Stats (health, speed, bites, score) live in the archetype tables, see archetypes.h.
+// Only the sprite sheet layouts are kept here.
 
+// Regular Zombie animation properties
 const int REGULAR_ZOMBIE_TOTAL_SPRITE_ROWS = 2; // Total rows in the regular zombie sprite sheet (e.g., walking, eating)
 const int REGULAR_ZOMBIE_WALKING_NUM_FRAMES = 10;    // Number of frames for walking animation (e.g., in row 0)
 const float REGULAR_ZOMBIE_WALKING_FRAME_SPEED = 0.25f; // Speed of walking animation (seconds per frame)
 const int REGULAR_ZOMBIE_EATING_NUM_FRAMES = 10;     // Number of frames for eating animation (e.g., in row 1)
 const float REGULAR_ZOMBIE_EATING_FRAME_SPEED = 0.15f; // Speed of eating animation
 
-// Jumping Zombie specific stats and animation properties
-const int JUMPING_ZOMBIE_HEALTH = 150;      // Jumping zombies are often tougher
-const float JUMPING_ZOMBIE_SPEED = 25.0f;   // May be slightly faster to make jumps more challenging
-
+// Jumping Zombie animation properties
 const int JUMPING_ZOMBIE_NUM_FRAMES = 6;    // Number of frames for jumping zombie animation
 const float JUMPING_ZOMBIE_FRAME_SPEED = 0.15f; // Animation speed for jumping zombie
 const int JUMPING_ZOMBIE_TOTAL_SPRITE_ROWS = 1; // Assuming one row for jumping zombie animation
 
-// Zombie Score Values (points awarded when a zombie is defeated)
-const int REGULAR_ZOMBIE_SCORE_VALUE = 100;
-const int JUMPING_ZOMBIE_SCORE_VALUE = 200;
-
 //----------------------------------------------------------------------------------
 // Plant Constants
-// Define constants for different plant types here.
+// Costs, health, fire rates and sun production are in PLANT_ARCHETYPES (archetypes.h).
 //----------------------------------------------------------------------------------
 
-// Peashooter
-const int PEASHOOTER_HEALTH = 100;
-const int PEASHOOTER_DAMAGE = 20;
-
-// Sunflower
-const int SUNFLOWER_HEALTH = 80;
-const float SUNFLOWER_SUN_GENERATION_INTERVAL = 0.1f; // Seconds between sun generation
-
-// Add other plant types (Wall-nut, Cherry Bomb, Snow Pea, etc.) as needed
-// Example:
-// const int WALNUT_HEALTH = 500; // High health
-// const int CHERRY_BOMB_HEALTH = 1; // Low health, explodes on contact/timer
-// const int CHERRY_BOMB_EXPLOSION_RADIUS = 2; // Grid tiles radius
-
 #endif // GAME_CONSTANTS_H
\ No newline at end of file
@@ -0,0 +1,283 @@
+// horde_renderer.cpp
+#include "horde_renderer.h"
+#include "game_constants.h"
+#include "logger.h"
+#include "render_device.h"
+#include "rlgl.h"
+#include <cmath>     // For floorf, fmodf
+#include <cstddef>   // For offsetof
+
+// Sized like the simulation's zombies, see Simulation::SpawnZombie
+const HordeSheet HORDE_SHEETS[(int)HordeSheetId::COUNT] = {
+    // Regular zombies only walk here, row 0 of their sheet
+    { SpriteId::REGULAR_ZOMBIE, REGULAR_ZOMBIE_WALKING_NUM_FRAMES, REGULAR_ZOMBIE_TOTAL_SPRITE_ROWS,
+      REGULAR_ZOMBIE_WALKING_FRAME_SPEED, { TILE_SIZE / 2.0f * 2.8f, TILE_SIZE / 2.0f * 2.8f } },
+    { SpriteId::JUMPING_ZOMBIE, JUMPING_ZOMBIE_NUM_FRAMES, JUMPING_ZOMBIE_TOTAL_SPRITE_ROWS,
+      JUMPING_ZOMBIE_FRAME_SPEED, { TILE_SIZE / 2.0f * 2.8f, TILE_SIZE / 2.0f * 2.8f } },
+};
+
+namespace {
+    const int INITIAL_INSTANCE_CAPACITY = 4096;
+
+    // Two triangles covering the unit square, scaled by the shader
+    const float QUAD_VERTICES[] = {
+        0.0f, 0.0f,  0.0f, 1.0f,  1.0f, 1.0f,
+        0.0f, 0.0f,  1.0f, 1.0f,  1.0f, 0.0f,
+    };
+
+    const char* HORDE_VERTEX_SHADER =
+        "#version 330\n"
+        "in vec2 vertexPosition;\n"
+        "in vec4 instanceData;\n"      // x, y, frame, sheet row
+        "in vec4 instanceTint;\n"
+        "uniform mat4 mvp;\n"
+        "uniform vec4 sheetRect;\n"    // Sprite in the page, normalized
+        "uniform vec2 sheetLayout;\n"  // Frames per row, rows
+        "uniform vec2 frameSize;\n"    // On screen, pixels
+        "out vec2 fragTexCoord;\n"
+        "out vec4 fragColor;\n"
+        "void main()\n"
+        "{\n"
+        "    vec2 cellSize = sheetRect.zw / sheetLayout;\n"
+        "    vec2 cell = vec2(floor(instanceData.z), instanceData.w);\n"
+        "    fragTexCoord = sheetRect.xy + (cell + vertexPosition) * cellSize;\n"
+        "    fragColor = instanceTint;\n"
+        "    gl_Position = mvp * vec4(instanceData.xy + vertexPosition * frameSize, 0.0, 1.0);\n"
+        "}\n";
+
+    const char* HORDE_FRAGMENT_SHADER =
+        "#version 330\n"
+        "in vec2 fragTexCoord;\n"
+        "in vec4 fragColor;\n"
+        "uniform sampler2D texture0;\n"
+        "out vec4 finalColor;\n"
+        "void main()\n"
+        "{\n"
+        "    finalColor = texture(texture0, fragTexCoord) * fragColor;\n"
+        "}\n";
+
+    // raymath's MatrixMultiply(left, right), without its header's warnings. Element mN
+    // sits at (N % 4) * 4 + N / 4 in the struct, as Matrix lists its fields row by row.
+    Matrix MultiplyMatrices(const Matrix& left, const Matrix& right) {
+        const float* l = &left.m0;
+        const float* r = &right.m0;
+        Matrix result;
+        float* out = &result.m0;
+        auto at = [](int n) { return (n % 4) * 4 + n / 4; };
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 4; ++row) {
+                float sum = 0.0f;
+                for (int k = 0; k < 4; ++k) sum += l[at(column * 4 + k)] * r[at(k * 4 + row)];
+                out[at(column * 4 + row)] = sum;
+            }
+        }
+        return result;
+    }
+}
+
+// Same math as the vertex shader, in sprite pixels
+Rectangle HordeFrameSource(const HordeSheet& sheet, Vector2 spriteSize, const HordeInstance& instance) {
+    float cellWidth = spriteSize.x / sheet.numFrames;
+    float cellHeight = spriteSize.y / sheet.numRows;
+    return Rectangle{ floorf(instance.frame) * cellWidth, instance.row * cellHeight, cellWidth, cellHeight };
+}
+
+//----------------------------------------------------------------------------------
+// Horde Renderer Implementation
+//----------------------------------------------------------------------------------
+HordeRenderer::HordeRenderer()
+    : shader{}, mvpLoc(-1), sheetRectLoc(-1), sheetLayoutLoc(-1), frameSizeLoc(-1),
+      instanceDataLoc(-1), instanceTintLoc(-1), vao(0), quadVbo(0), instanceVbo(0), instanceCapacity(0),
+      instancingSupported(false), instancingEnabled(true), drawCalls(0)
+{
+}
+
+void HordeRenderer::Load() {
+    if (RenderIsSoftware()) {
+        GAME_LOG_INFO(LogCategory::ASSETS, "Software renderer, the stress horde is drawn on the CPU");
+        return;
+    }
+    int glVersion = rlGetVersion();
+    if (glVersion != RL_OPENGL_33 && glVersion != RL_OPENGL_43) {
+        GAME_LOG_WARNING(LogCategory::ASSETS, "No GLSL 330 instancing, the stress horde is drawn on the CPU");
+        return;
+    }
+
+    shader = LoadShaderFromMemory(HORDE_VERTEX_SHADER, HORDE_FRAGMENT_SHADER);
+    // A failed compile leaves raylib's default shader in place
+    if (!IsShaderValid(shader) || shader.id == rlGetShaderIdDefault()) {
+        GAME_LOG_WARNING(LogCategory::ASSETS, "Horde shader failed to build, the stress horde is drawn on the CPU");
+        shader = Shader{};
+        return;
+    }
+    mvpLoc = rlGetLocationUniform(shader.id, "mvp");
+    sheetRectLoc = rlGetLocationUniform(shader.id, "sheetRect");
+    sheetLayoutLoc = rlGetLocationUniform(shader.id, "sheetLayout");
+    frameSizeLoc = rlGetLocationUniform(shader.id, "frameSize");
+    instanceDataLoc = rlGetLocationAttrib(shader.id, "instanceData");
+    instanceTintLoc = rlGetLocationAttrib(shader.id, "instanceTint");
+
+    vao = rlLoadVertexArray();
+    if (vao == 0 || instanceDataLoc < 0 || instanceTintLoc < 0) {
+        GAME_LOG_WARNING(LogCategory::ASSETS, "No vertex arrays for the horde, the stress horde is drawn on the CPU");
+        Unload();
+        return;
+    }
+    rlEnableVertexArray(vao);
+    quadVbo = rlLoadVertexBuffer(QUAD_VERTICES, sizeof(QUAD_VERTICES), false);
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION, 2, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION);
+    instancingSupported = CreateInstanceBuffer(INITIAL_INSTANCE_CAPACITY);
+    rlDisableVertexArray();
+
+    GAME_LOG_INFO(LogCategory::ASSETS, "Stress horde drawn with %s", instancingSupported ? "GPU instancing" : "the CPU batch");
+}
+
+void HordeRenderer::Unload() {
+    if (instanceVbo != 0) rlUnloadVertexBuffer(instanceVbo);
+    if (quadVbo != 0) rlUnloadVertexBuffer(quadVbo);
+    if (vao != 0) rlUnloadVertexArray(vao);
+    if (shader.id != 0) UnloadShader(shader);
+    shader = Shader{};
+    vao = quadVbo = instanceVbo = 0;
+    instanceCapacity = 0;
+    instancingSupported = false;
+}
+
+// Expects the VAO to be bound; the attribute pointers refer to the new buffer
+bool HordeRenderer::CreateInstanceBuffer(int capacity) {
+    if (instanceVbo != 0) rlUnloadVertexBuffer(instanceVbo);
+    instanceVbo = rlLoadVertexBuffer(nullptr, capacity * (int)sizeof(HordeInstance), true);
+    if (instanceVbo == 0) {
+        instanceCapacity = 0;
+        return false;
+    }
+    instanceCapacity = capacity;
+
+    rlSetVertexAttribute(instanceDataLoc, 4, RL_FLOAT, false, sizeof(HordeInstance), 0);
+    rlEnableVertexAttribute(instanceDataLoc);
+    rlSetVertexAttributeDivisor(instanceDataLoc, 1);
+    rlSetVertexAttribute(instanceTintLoc, 4, RL_UNSIGNED_BYTE, true, sizeof(HordeInstance), offsetof(HordeInstance, tint));
+    rlEnableVertexAttribute(instanceTintLoc);
+    rlSetVertexAttributeDivisor(instanceTintLoc, 1);
+    return true;
+}
+
+void HordeRenderer::Draw(const TextureAtlas& atlas, const HordeSheet& sheet, const std::vector<HordeInstance>& instances) {
+    if (instances.empty()) return;
+    const AtlasSprite& sprite = atlas.GetSprite(sheet.sprite);
+    if (sprite.page < 0 || sprite.page >= atlas.GetPageCount()) return;
+    const Texture2D& page = atlas.GetPageTexture(sprite.page);
+
+    if (IsInstanced()) DrawInstanced(page, sprite.source, sheet, instances);
+    else DrawBatched(page, sprite.source, sheet, instances);
+}
+
+void HordeRenderer::DrawInstanced(const Texture2D& page, Rectangle spriteRect, const HordeSheet& sheet,
+                                  const std::vector<HordeInstance>& instances) {
+    rlDrawRenderBatchActive(); // Whatever raylib queued so far goes first
+    drawCalls++;
+
+    rlEnableVertexArray(vao);
+    if ((int)instances.size() > instanceCapacity) {
+        int capacity = instanceCapacity;
+        while (capacity < (int)instances.size()) capacity *= 2;
+        if (!CreateInstanceBuffer(capacity)) {
+            rlDisableVertexArray();
+            instancingSupported = false;
+            GAME_LOG_WARNING(LogCategory::ASSETS, "Horde instance buffer failed to grow, falling back to the CPU batch");
+            DrawBatched(page, spriteRect, sheet, instances);
+            return;
+        }
+    }
+    rlUpdateVertexBuffer(instanceVbo, instances.data(), (int)(instances.size() * sizeof(HordeInstance)), 0);
+
+    rlEnableShader(shader.id);
+    Matrix mvp = MultiplyMatrices(rlGetMatrixModelview(), rlGetMatrixProjection());
+    rlSetUniformMatrix(mvpLoc, mvp);
+    float sheetRect[4] = { spriteRect.x / page.width, spriteRect.y / page.height,
+                           spriteRect.width / page.width, spriteRect.height / page.height };
+    float sheetLayout[2] = { (float)sheet.numFrames, (float)sheet.numRows };
+    rlSetUniform(sheetRectLoc, sheetRect, RL_SHADER_UNIFORM_VEC4, 1);
+    rlSetUniform(sheetLayoutLoc, sheetLayout, RL_SHADER_UNIFORM_VEC2, 1);
+    rlSetUniform(frameSizeLoc, &sheet.size, RL_SHADER_UNIFORM_VEC2, 1);
+    rlActiveTextureSlot(0);
+    rlEnableTexture(page.id);
+
+    rlDrawVertexArrayInstanced(0, 6, (int)instances.size());
+
+    rlDisableTexture();
+    rlDisableShader();
+    rlDisableVertexArray();
+}
+
+void HordeRenderer::DrawBatched(const Texture2D& page, Rectangle spriteRect, const HordeSheet& sheet,
+                                const std::vector<HordeInstance>& instances) {
+    Vector2 spriteSize = { spriteRect.width, spriteRect.height };
+    fallbackBatch.Begin();
+    for (const HordeInstance& instance : instances) {
+        Rectangle source = HordeFrameSource(sheet, spriteSize, instance);
+        source.x += spriteRect.x;
+        source.y += spriteRect.y;
+        fallbackBatch.Add(SpriteLayer::ZOMBIES, 0, page, source,
+                          (Rectangle){ instance.x, instance.y, sheet.size.x, sheet.size.y }, instance.tint);
+    }
+    fallbackBatch.End();
+    drawCalls += fallbackBatch.GetFrameStats().drawCalls;
+}
+
+//----------------------------------------------------------------------------------
+// Stress Horde Implementation
+//----------------------------------------------------------------------------------
+void StressHorde::Spawn(int count, Rectangle lawn, int lanes) {
+    Clear();
+    area = lawn;
+    random.seed(STRESS_HORDE_SEED);
+    auto randomInt = [this](int min, int max) { return std::uniform_int_distribution<int>(min, max)(random); };
+    float laneHeight = lawn.height / lanes;
+    for (int i = 0; i < count; ++i) {
+        int sheetIndex = i % (int)HordeSheetId::COUNT;
+        const HordeSheet& sheet = HORDE_SHEETS[sheetIndex];
+        int lane = randomInt(0, lanes - 1);
+
+        HordeInstance instance;
+        instance.x = lawn.x + randomInt(0, (int)lawn.width);
+        instance.y = lawn.y + lane * laneHeight + laneHeight / 4.0f;
+        instance.frame = (float)randomInt(0, sheet.numFrames - 1);
+        instance.row = 0.0f;
+        instance.tint = WHITE;
+        instances[sheetIndex].push_back(instance);
+        speeds[sheetIndex].push_back((float)randomInt(15, 30));
+    }
+}
+
+void StressHorde::Clear() {
+    for (int i = 0; i < (int)HordeSheetId::COUNT; ++i) {
+        instances[i].clear();
+        speeds[i].clear();
+    }
+}
+
+bool StressHorde::IsEmpty() const {
+    return GetCount() == 0;
+}
+
+int StressHorde::GetCount() const {
+    int count = 0;
+    for (const auto& sheetInstances : instances) count += (int)sheetInstances.size();
+    return count;
+}
+
+void StressHorde::Update(float deltaTime) {
+    for (int sheetIndex = 0; sheetIndex < (int)HordeSheetId::COUNT; ++sheetIndex) {
+        const HordeSheet& sheet = HORDE_SHEETS[sheetIndex];
+        float frameStep = deltaTime / sheet.frameSpeed;
+        std::vector<HordeInstance>& sheetInstances = instances[sheetIndex];
+        for (size_t i = 0; i < sheetInstances.size(); ++i) {
+            HordeInstance& instance = sheetInstances[i];
+            instance.x -= speeds[sheetIndex][i] * deltaTime;
+            if (instance.x + sheet.size.x < area.x) instance.x = area.x + area.width; // Back in from the right
+            instance.frame = fmodf(instance.frame + frameStep, (float)sheet.numFrames);
+        }
+    }
+}
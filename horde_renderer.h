@@ -0,0 +1,116 @@
+// horde_renderer.h
+#ifndef HORDE_RENDERER_H
+#define HORDE_RENDERER_H
+
+#include "raylib.h"
+#include <vector>
+#include <random>
+#include "texture_atlas.h"
+#include "sprite_batch.h"
+
+//----------------------------------------------------------------------------------
+// Horde Renderer
+// Stress mode puts STRESS_HORDE_SIZE animated zombies on the lawn, far more
+// than a real level, to find where rendering breaks down. At that count even
+// the sprite batch spends its time building quads on the CPU. This path
+// uploads one small record per zombie (position, frame, sheet row, tint) and
+// draws the whole horde with a single instanced call; a vertex shader turns the
+// frame and row into UVs from the sheet layout.
+//
+// Where instancing or GLSL 330 is not available (or when it is switched off to
+// compare), the same records go through a SpriteBatch instead, using
+// HordeFrameSource, the CPU twin of the shader's UV math. Stress zombies live on
+// the main thread only: they walk and animate, nothing else. They draw their
+// placement from their own generator, as raylib's GetRandomValue belongs to the
+// simulation thread.
+//----------------------------------------------------------------------------------
+const int STRESS_HORDE_SIZE = 10000;
+const unsigned int STRESS_HORDE_SEED = 12345; // Every stress run places the horde the same way
+
+// Per-instance vertex data, the layout the shader's attributes expect
+struct HordeInstance {
+    float x;
+    float y;
+    float frame;  // Fractional while animating, the shader floors it
+    float row;    // Sheet row
+    Color tint;
+};
+
+struct HordeSheet {
+    SpriteId sprite;
+    int numFrames;     // Per row
+    int numRows;
+    float frameSpeed;  // Seconds per frame
+    Vector2 size;      // On screen
+};
+
+enum class HordeSheetId {
+    REGULAR_ZOMBIE,
+    JUMPING_ZOMBIE,
+    COUNT
+};
+
+extern const HordeSheet HORDE_SHEETS[(int)HordeSheetId::COUNT];
+
+// Source rect of an instance's frame, relative to the sprite
+Rectangle HordeFrameSource(const HordeSheet& sheet, Vector2 spriteSize, const HordeInstance& instance);
+
+class HordeRenderer {
+public:
+    HordeRenderer();
+
+    // After InitWindow; without instancing support every Draw takes the CPU path
+    void Load();
+    void Unload();
+
+    void SetInstancingEnabled(bool enabled) { instancingEnabled = enabled; }
+    bool IsInstanced() const { return instancingSupported && instancingEnabled; }
+
+    void Draw(const TextureAtlas& atlas, const HordeSheet& sheet, const std::vector<HordeInstance>& instances);
+
+    int GetDrawCalls() const { return drawCalls; } // Since the last ResetStats
+    void ResetStats() { drawCalls = 0; }
+
+private:
+    bool CreateInstanceBuffer(int capacity);
+    void DrawInstanced(const Texture2D& page, Rectangle spriteRect, const HordeSheet& sheet, const std::vector<HordeInstance>& instances);
+    void DrawBatched(const Texture2D& page, Rectangle spriteRect, const HordeSheet& sheet, const std::vector<HordeInstance>& instances);
+
+    Shader shader;
+    int mvpLoc;
+    int sheetRectLoc;
+    int sheetLayoutLoc;
+    int frameSizeLoc;
+    int instanceDataLoc;
+    int instanceTintLoc;
+    unsigned int vao;
+    unsigned int quadVbo;
+    unsigned int instanceVbo;
+    int instanceCapacity;
+    bool instancingSupported;
+    bool instancingEnabled;
+    SpriteBatch fallbackBatch;
+    int drawCalls;
+};
+
+// The stress zombies themselves, plain records per sheet
+class StressHorde {
+public:
+    // Spreads 'count' zombies over the lanes of 'lawn', half of each sheet
+    void Spawn(int count, Rectangle lawn, int lanes);
+    void Clear();
+    bool IsEmpty() const;
+    // Walks them left, wrapping around the lawn, and advances their animation
+    void Update(float deltaTime);
+
+    const std::vector<HordeInstance>& GetInstances(HordeSheetId sheet) const { return instances[(int)sheet]; }
+    int GetCount() const;
+
+private:
+    std::vector<HordeInstance> instances[(int)HordeSheetId::COUNT];
+    std::vector<float> speeds[(int)HordeSheetId::COUNT];
+    Rectangle area;
+    std::mt19937 random;
+};
+
+#endif // HORDE_RENDERER_H
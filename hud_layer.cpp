@@ -0,0 +1,194 @@
+// hud_layer.cpp
+#include "hud_layer.h"
+#include "archetypes.h"
+#include "logger.h"
+#include "render_device.h"
+#include <algorithm> // For std::min, std::max
+
+namespace {
+    const int HUD_TEXT_SIZE = 20;
+    const int HUD_LINE_SPACING = 25;
+    const int PRICE_TEXT_SIZE = 15;
+    const int PRICE_OFFSET = 5;        // Between an icon and its price
+    const float HIGHLIGHT_THICKNESS = 3.0f;
+    const unsigned int ALL_ELEMENTS = (1u << (int)HudElement::COUNT) - 1;
+
+    unsigned int Bit(HudElement element) { return 1u << (int)element; }
+}
+
+//----------------------------------------------------------------------------------
+// HUD Layer Implementation
+//----------------------------------------------------------------------------------
+HudLayer::HudLayer(const HudLayout& layout, const TextureAtlas& atlas, const Texture2D& grass)
+    : layout(layout), atlas(atlas), grass(grass), target{}, cached(false), dirtyMask(ALL_ELEMENTS),
+      sun(0), score(0), level(1), targetScore(0), selection(PlantType::NONE), muted(false)
+{
+    for (int& count : repaints) count = 0;
+}
+
+void HudLayer::Load(int width, int height) {
+    // The software device has no render textures, the HUD is drawn directly there
+    if (!RenderIsSoftware()) target = LoadRenderTexture(width, height);
+    cached = IsRenderTextureValid(target);
+    if (!cached && !RenderIsSoftware()) {
+        GAME_LOG_WARNING(LogCategory::UI, "HUD render texture unavailable, drawing the HUD directly");
+    }
+    dirtyMask = ALL_ELEMENTS;
+}
+
+void HudLayer::Unload() {
+    if (cached) UnloadRenderTexture(target);
+    target = RenderTexture2D{};
+    cached = false;
+}
+
+void HudLayer::SetSun(int value) {
+    if (value == sun) return;
+    sun = value;
+    dirtyMask |= Bit(HudElement::SUN);
+}
+
+void HudLayer::SetScore(int value) {
+    if (value == score) return;
+    score = value;
+    dirtyMask |= Bit(HudElement::SCORE);
+}
+
+void HudLayer::SetLevel(int levelValue, int targetValue) {
+    if (levelValue == level && targetValue == targetScore) return;
+    level = levelValue;
+    targetScore = targetValue;
+    dirtyMask |= Bit(HudElement::LEVEL);
+}
+
+void HudLayer::SetSelection(PlantType plant) {
+    if (plant == selection) return;
+    selection = plant;
+    dirtyMask |= Bit(HudElement::SELECTION);
+}
+
+void HudLayer::SetMuted(bool value) {
+    if (value == muted) return;
+    muted = value;
+    dirtyMask |= Bit(HudElement::MUTE);
+}
+
+void HudLayer::Invalidate() {
+    dirtyMask = ALL_ELEMENTS;
+}
+
+void HudLayer::Update() {
+    if (dirtyMask == 0) return;
+    if (!cached) {
+        dirtyMask = 0; // Draw paints everything anyway
+        return;
+    }
+
+    BeginTextureMode(target);
+    if (dirtyMask & Bit(HudElement::BACKGROUND)) {
+        ClearBackground(BLANK); // Outside the panel and the lawn the frame's clear color shows through
+        dirtyMask = ALL_ELEMENTS;
+    }
+    for (int i = 0; i < (int)HudElement::COUNT; ++i) {
+        if ((dirtyMask & Bit((HudElement)i)) == 0) continue;
+        Paint((HudElement)i);
+        ++repaints[i];
+    }
+    EndTextureMode();
+    dirtyMask = 0;
+}
+
+void HudLayer::Draw() const {
+    if (!cached) {
+        for (int i = 0; i < (int)HudElement::COUNT; ++i) Paint((HudElement)i);
+        return;
+    }
+    // Render textures are stored bottom-up, hence the negative height
+    RenderTexturedRect(target.texture, (Rectangle){ 0, 0, (float)target.texture.width, -(float)target.texture.height },
+                       (Rectangle){ 0, 0, (float)target.texture.width, (float)target.texture.height }, WHITE);
+}
+
+void HudLayer::DrawBackground() const {
+    RenderRect(layout.panel, layout.panelColor);
+    if (!cached) {
+        RenderTexturedRect(grass, (Rectangle){ 0, 0, (float)grass.width, (float)grass.height }, layout.lawn, WHITE);
+        return;
+    }
+    const Rectangle& lawn = layout.lawn;
+    Rectangle source = { lawn.x, target.texture.height - (lawn.y + lawn.height), lawn.width, -lawn.height };
+    RenderTexturedRect(target.texture, source, lawn, WHITE);
+}
+
+// Every element but the background lies on the plain panel, so painting the
+// panel color over its rect erases the previous value
+void HudLayer::Paint(HudElement element) const {
+    if (element == HudElement::BACKGROUND) {
+        RenderRect(layout.panel, layout.panelColor);
+        RenderTexturedRect(grass, (Rectangle){ 0, 0, (float)grass.width, (float)grass.height }, layout.lawn, WHITE);
+        atlas.DrawEx(SpriteId::PAUSE_BUTTON, (Vector2){ layout.pauseButton.x, layout.pauseButton.y }, 1.0f, WHITE);
+        return;
+    }
+
+    RenderRect(GetElementRect(element), layout.panelColor);
+    int x = (int)layout.textOrigin.x;
+    int y = (int)layout.textOrigin.y;
+    switch (element) {
+        case HudElement::SUN:
+            RenderText(TextFormat("Sun: $%d", sun), x, y, HUD_TEXT_SIZE, YELLOW);
+            break;
+        case HudElement::SCORE:
+            RenderText(TextFormat("Score: %d", score), x, y + HUD_LINE_SPACING, HUD_TEXT_SIZE, WHITE);
+            break;
+        case HudElement::LEVEL:
+            RenderText(TextFormat("Level: %d | Target: %d", level, targetScore), x, y + HUD_LINE_SPACING * 2, HUD_TEXT_SIZE, RAYWHITE);
+            break;
+        case HudElement::SELECTION:
+            for (int i = 0; i < layout.iconCount; ++i) {
+                const HudIcon& icon = layout.icons[i];
+                const PlantArchetype& archetype = GetPlantArchetype(icon.plant);
+                // Icons are drawn as wide as their rect, whatever the sprite's own size
+                float spriteWidth = atlas.GetSprite(archetype.sprite).source.width;
+                if (spriteWidth > 0) {
+                    atlas.DrawEx(archetype.sprite, (Vector2){ icon.rect.x, icon.rect.y }, icon.rect.width / spriteWidth, WHITE);
+                }
+                RenderText(TextFormat("$%d", archetype.cost), (int)icon.rect.x, (int)(icon.rect.y + icon.rect.height) + PRICE_OFFSET,
+                           PRICE_TEXT_SIZE, WHITE);
+                if (icon.plant == selection) RenderRectLines(icon.rect, HIGHLIGHT_THICKNESS, YELLOW);
+            }
+            break;
+        case HudElement::MUTE: {
+            SpriteId sprite = muted ? SpriteId::MUTE : SpriteId::UNMUTE;
+            float spriteWidth = atlas.GetSprite(sprite).source.width;
+            if (spriteWidth > 0) {
+                atlas.DrawEx(sprite, (Vector2){ layout.muteButton.x, layout.muteButton.y }, layout.muteButton.width / spriteWidth, WHITE);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+Rectangle HudLayer::GetElementRect(HudElement element) const {
+    if (element == HudElement::MUTE) return layout.muteButton;
+    if (element == HudElement::SELECTION) {
+        if (layout.iconCount == 0) return Rectangle{ 0, 0, 0, 0 };
+        // The icon strip down to the bottom of the panel: sprites scaled to their
+        // rect's width may run past its height, the prices sit below it anyway
+        float left = layout.icons[0].rect.x, top = layout.icons[0].rect.y;
+        float right = left;
+        for (int i = 0; i < layout.iconCount; ++i) {
+            const Rectangle& rect = layout.icons[i].rect;
+            left = std::min(left, rect.x);
+            top = std::min(top, rect.y);
+            right = std::max(right, rect.x + rect.width);
+        }
+        return Rectangle{ left, top, right - left, layout.panel.y + layout.panel.height - top };
+    }
+
+    // Text lines run from the text origin to the first icon
+    int line = (int)element - (int)HudElement::SUN;
+    float right = layout.iconCount > 0 ? layout.icons[0].rect.x : layout.panel.x + layout.panel.width;
+    return Rectangle{ layout.textOrigin.x, layout.textOrigin.y + line * HUD_LINE_SPACING,
+                      right - layout.textOrigin.x, (float)HUD_LINE_SPACING };
+}
@@ -0,0 +1,94 @@
+// hud_layer.h
+#ifndef HUD_LAYER_H
+#define HUD_LAYER_H
+
+#include "raylib.h"
+#include "plant.h"         // For PlantType
+#include "texture_atlas.h"
+
+//----------------------------------------------------------------------------------
+// HUD Layer
+// The UI panel, the lawn background, the plant icons with their prices and the
+// pause and mute buttons hardly ever change, yet they used to cost some thirty
+// draw calls every frame. They are composited into a screen-sized
+// RenderTexture2D instead, and a frame only blits that one quad. Sun, score,
+// level, the selected plant and the mute state are dirty-tracked separately: a
+// change repaints just that element's part of the texture. If the render
+// texture can't be created, everything is drawn directly each frame like before.
+//----------------------------------------------------------------------------------
+enum class HudElement {
+    BACKGROUND, // Panel, lawn and pause button; repainting it repaints everything
+    SUN,
+    SCORE,
+    LEVEL,      // Level and target score
+    SELECTION,  // Plant icons, prices and the highlight around the selected one
+    MUTE,       // Mute button, its sprite shows the music state
+    COUNT
+};
+
+const int HUD_MAX_ICONS = 8;
+
+// Icons and buttons come from the UI widget table (see ui_layout.h), which also hit-tests them
+struct HudIcon {
+    PlantType plant;   // Sprite and price come from its archetype
+    Rectangle rect;
+};
+
+struct HudLayout {
+    Rectangle panel;
+    Color panelColor;
+    Rectangle lawn;              // Where the grass background is stretched to
+    Vector2 textOrigin;          // Sun line, score and level follow below it
+    HudIcon icons[HUD_MAX_ICONS];
+    int iconCount;
+    Rectangle pauseButton;
+    Rectangle muteButton;
+};
+
+class HudLayer {
+public:
+    // The atlas and the grass texture must outlive the layer
+    HudLayer(const HudLayout& layout, const TextureAtlas& atlas, const Texture2D& grass);
+
+    // After InitWindow
+    void Load(int width, int height);
+    void Unload();
+
+    // Cheap to call every frame, only a different value marks the element dirty
+    void SetSun(int value);
+    void SetScore(int value);
+    void SetLevel(int level, int targetScore);
+    void SetSelection(PlantType plant);
+    void SetMuted(bool value);
+    void Invalidate(); // Everything dirty, e.g. after the textures were reloaded
+
+    // Repaints the dirty elements into the cache, call before BeginDrawing
+    void Update();
+    // The whole HUD, one quad
+    void Draw() const;
+    // Panel and lawn only, for the overlays that hide the HUD
+    void DrawBackground() const;
+
+    int GetRepaintCount(HudElement element) const { return repaints[(int)element]; }
+
+private:
+    void Paint(HudElement element) const;
+    Rectangle GetElementRect(HudElement element) const;
+
+    HudLayout layout;
+    const TextureAtlas& atlas;
+    const Texture2D& grass;
+    RenderTexture2D target;
+    bool cached;              // False without a render texture
+    unsigned int dirtyMask;   // One bit per HudElement
+
+    int sun;
+    int score;
+    int level;
+    int targetScore;
+    PlantType selection;
+    bool muted;
+    int repaints[(int)HudElement::COUNT];
+};
+
+#endif // HUD_LAYER_H
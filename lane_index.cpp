@@ -0,0 +1,70 @@
+// lane_index.cpp
+#include "lane_index.h"
+#include "zombie.h"
+#include <algorithm> // For std::sort, std::lower_bound, std::upper_bound
+
+//----------------------------------------------------------------------------------
+// Lane Index Implementation
+//----------------------------------------------------------------------------------
+LaneIndex::LaneIndex(int numLanes)
+    : lanes(numLanes), maxWidth(numLanes, 0.0f)
+{
+}
+
+void LaneIndex::Rebuild(const std::vector<std::unique_ptr<Zombie>>& zombies) {
+    Clear();
+
+    for (const auto& zombie : zombies) {
+        if (!zombie->active || zombie->dormant || zombie->row < 0 || zombie->row >= (int)lanes.size()) continue;
+        lanes[zombie->row].push_back(zombie.get());
+        maxWidth[zombie->row] = std::max(maxWidth[zombie->row], zombie->rect.width);
+    }
+
+    for (auto& lane : lanes) {
+        std::sort(lane.begin(), lane.end(),
+                  [](const Zombie* a, const Zombie* b) { return a->rect.x < b->rect.x; });
+    }
+}
+
+void LaneIndex::Clear() {
+    for (auto& lane : lanes) lane.clear(); // Keeps capacity, no reallocation next tick
+    std::fill(maxWidth.begin(), maxWidth.end(), 0.0f);
+}
+
+void LaneIndex::QueryLane(int lane, float x0, float x1, std::vector<Zombie*>& out) const {
+    if (lane < 0 || lane >= (int)lanes.size()) return;
+
+    const std::vector<Zombie*>& bucket = lanes[lane];
+
+    // No zombie wider than maxWidth can reach x0 if it starts before x0 - maxWidth
+    auto it = std::lower_bound(bucket.begin(), bucket.end(), x0 - maxWidth[lane],
+                               [](const Zombie* z, float x) { return z->rect.x < x; });
+
+    for (; it != bucket.end() && (*it)->rect.x <= x1; ++it) {
+        Zombie* zombie = *it;
+        // Zombies can be killed after the rebuild (projectiles, other mowers), skip them
+        if (zombie->active && zombie->rect.x + zombie->rect.width >= x0) {
+            out.push_back(zombie);
+        }
+    }
+}
+
+void LaneIndex::QueryArea(int firstLane, int lastLane, float x0, float x1, std::vector<Zombie*>& out) const {
+    firstLane = std::max(firstLane, 0);
+    lastLane = std::min(lastLane, (int)lanes.size() - 1);
+    for (int lane = firstLane; lane <= lastLane; ++lane) {
+        QueryLane(lane, x0, x1, out);
+    }
+}
+
+bool LaneIndex::AnyRightOf(int lane, float x) const {
+    if (lane < 0 || lane >= (int)lanes.size()) return false;
+
+    const std::vector<Zombie*>& bucket = lanes[lane];
+    auto it = std::upper_bound(bucket.begin(), bucket.end(), x,
+                               [](float x, const Zombie* z) { return x < z->rect.x; });
+    for (; it != bucket.end(); ++it) {
+        if ((*it)->active) return true;
+    }
+    return false;
+}
@@ -0,0 +1,42 @@
+// lane_index.h
+#ifndef LANE_INDEX_H
+#define LANE_INDEX_H
+
+#include "raylib.h"
+#include <vector>
+#include <memory> // For std::unique_ptr
+
+// Forward declaration, the index only stores pointers to zombies
+class Zombie;
+
+//----------------------------------------------------------------------------------
+// Lane Index
+// Buckets active, awake zombies by grid row and keeps every bucket sorted by rect.x,
+// so lane-local queries only touch the zombies that are actually nearby.
+// Rebuilt once per tick after the zombies have moved.
+//----------------------------------------------------------------------------------
+class LaneIndex {
+public:
+    explicit LaneIndex(int numLanes);
+
+    void Rebuild(const std::vector<std::unique_ptr<Zombie>>& zombies);
+    void Clear();
+
+    // Appends every active zombie in 'lane' whose horizontal extent overlaps [x0, x1]
+    void QueryLane(int lane, float x0, float x1, std::vector<Zombie*>& out) const;
+    // Same as QueryLane for every lane in [firstLane, lastLane], clamped to the grid.
+    // Area-of-effect plants use this instead of testing a rectangle against every zombie.
+    void QueryArea(int firstLane, int lastLane, float x0, float x1, std::vector<Zombie*>& out) const;
+    // True when an active zombie in 'lane' starts strictly right of x (shooters' "zombie in lane" test)
+    bool AnyRightOf(int lane, float x) const;
+
+    int GetLaneCount() const { return (int)lanes.size(); }
+    const std::vector<Zombie*>& GetLane(int lane) const { return lanes[lane]; }
+    float GetMaxWidth(int lane) const { return maxWidth[lane]; }
+
+private:
+    std::vector<std::vector<Zombie*>> lanes; // Sorted by rect.x (left edge), ascending
+    std::vector<float> maxWidth;             // Widest zombie per lane, bounds the backwards search
+};
+
+#endif // LANE_INDEX_H
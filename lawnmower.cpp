@@ -1,7 +1,8 @@
 #include "lawnmower.h"
+#include "game_constants.h"
 
 LawnMower::LawnMower(Rectangle rect, int row, Texture2D texture)
-    : rect(rect), row(row), texture(texture), active(true), activated(false), speed(300.0f) // Adjusted speed
+    : rect(rect), row(row), texture(texture), active(true), activated(false), speed(300.0f), broadphaseId(-1) // Adjusted speed
 {
     // You might want to scale the texture to fit the rect here if it's not already sized correctly
     // For simplicity, we assume the texture is roughly TILE_SIZE/2.0f x TILE_SIZE/2.0f
@@ -14,8 +15,7 @@ void LawnMower::Update(float deltaTime) {
     }
 }
 
-void LawnMower::Draw() {
-    if (active) {
-        DrawTextureRec(texture, (Rectangle){0, 0, (float)texture.width, (float)texture.height}, {rect.x, rect.y}, WHITE);
-    }
+BroadphaseBounds LawnMower::GetBounds() const {
+    // Zombies past GRID_START_X - TILE_SIZE / 2 trigger the mower of their lane
+    return { rect.x, (float)GRID_START_X - TILE_SIZE / 2, row, row };
 }
\ No newline at end of file
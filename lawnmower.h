@@ -2,6 +2,7 @@
 #define LAWNMOWER_H
 
 #include "raylib.h"
+#include "broadphase.h"
 
 class LawnMower {
 public:
@@ -12,10 +13,14 @@ public:
     bool activated;  // If true, it has been triggered and is moving across the lane
 
     float speed;     // Speed at which the lawnmower moves
+    int broadphaseId; // Proxy id in the Broadphase while waiting to be triggered, -1 otherwise
 
     LawnMower(Rectangle rect, int row, Texture2D texture);
     void Update(float deltaTime);
-    void Draw();
+
+    // Broadphase footprint: from the mower up to its trigger line, a zombie overlapping it sets the mower off
+    BroadphaseBounds GetBounds() const;
+    static BroadphaseBounds BoundsOf(const void* owner) { return static_cast<const LawnMower*>(owner)->GetBounds(); }
 };
 
 #endif // LAWNMOWER_H
\ No newline at end of file
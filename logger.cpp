@@ -0,0 +1,171 @@
+// logger.cpp
+#include "logger.h"
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <memory>  // For std::unique_ptr
+#include <chrono>
+#include <cstdio>  // For vsnprintf, fwrite
+#include <cstdarg> // For va_list
+
+namespace {
+    const int LOG_RING_SIZE = 256;      // Records per thread, power of two
+    const int LOG_TEXT_SIZE = 232;      // Longer messages are truncated
+    const int LOG_WRITER_IDLE_MS = 5;   // Writer sleep when every ring is empty
+
+    struct LogRecord {
+        double time; // Seconds since the logger was first used
+        LogLevel level;
+        LogCategory category;
+        char text[LOG_TEXT_SIZE];
+    };
+
+    // Single producer (the owning thread), single consumer (the writer thread)
+    struct LogRing {
+        LogRecord records[LOG_RING_SIZE];
+        std::atomic<unsigned int> head{0}; // Next record to write out, advanced by the writer
+        std::atomic<unsigned int> tail{0}; // Next free record, advanced by the owner
+    };
+
+    const char* LEVEL_NAMES[] = { "VERBOSE", "INFO", "WARNING", "CRITICAL" };
+    const char* CATEGORY_NAMES[] = { "GAMEPLAY", "UI", "AUDIO", "ASSETS" };
+
+    // Rings are never freed: a thread may still hold its ring after LogStop. When a thread
+    // exits its ring goes on freeRings for the next new thread, so short-lived threads such
+    // as the AssetLoader's reuse rings instead of adding one each launch.
+    std::mutex ringsMutex; // Taken when a thread first logs or exits, and briefly by the writer to list the rings
+    std::vector<std::unique_ptr<LogRing>> rings;
+    std::vector<LogRing*> freeRings;
+
+    // The calling thread's ring, handed back to freeRings when the thread exits. Records
+    // still queued in it stay there until the writer drains them.
+    struct RingOwner {
+        LogRing* ring = nullptr;
+        ~RingOwner() {
+            if (!ring) return;
+            std::lock_guard<std::mutex> lock(ringsMutex);
+            freeRings.push_back(ring);
+        }
+    };
+    thread_local RingOwner threadRing;
+
+    std::thread writerThread;
+    std::atomic<bool> writerRunning{false};
+    std::atomic<unsigned int> enabledCategories{~0u};
+    std::atomic<unsigned long long> droppedCount{0};
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    LogRing* GetThreadRing() {
+        if (!threadRing.ring) {
+            std::lock_guard<std::mutex> lock(ringsMutex);
+            // Only a drained ring is reused, a new thread should not start with a backlog
+            for (size_t i = 0; i < freeRings.size() && !threadRing.ring; ++i) {
+                LogRing* ring = freeRings[i];
+                if (ring->head.load(std::memory_order_acquire) == ring->tail.load(std::memory_order_relaxed)) {
+                    threadRing.ring = ring;
+                    freeRings.erase(freeRings.begin() + i);
+                }
+            }
+            if (!threadRing.ring) {
+                rings.emplace_back(new LogRing());
+                threadRing.ring = rings.back().get();
+            }
+        }
+        return threadRing.ring;
+    }
+
+    // Writes out everything queued so far, returns false when there was nothing
+    bool DrainRings() {
+        bool wroteAny = false;
+        char line[LOG_TEXT_SIZE + 64];
+
+        // Only listing the rings needs the lock, the output happens without it. Only the writer
+        // drains (LogStop after joining it), so one list is enough.
+        static std::vector<LogRing*> drainList;
+        {
+            std::lock_guard<std::mutex> lock(ringsMutex);
+            drainList.clear();
+            for (const auto& ring : rings) drainList.push_back(ring.get());
+        }
+        for (LogRing* ring : drainList) {
+            unsigned int head = ring->head.load(std::memory_order_relaxed);
+            unsigned int tail = ring->tail.load(std::memory_order_acquire);
+            for (; head != tail; ++head) {
+                const LogRecord& record = ring->records[head & (LOG_RING_SIZE - 1)];
+                int length = snprintf(line, sizeof(line), "[%9.3f] [%s] [%s] %s\n", record.time,
+                                      LEVEL_NAMES[(int)record.level], CATEGORY_NAMES[(int)record.category], record.text);
+                if (length > (int)sizeof(line) - 1) length = (int)sizeof(line) - 1;
+                if (length > 0) fwrite(line, 1, (size_t)length, stdout);
+                wroteAny = true;
+            }
+            ring->head.store(head, std::memory_order_release); // Hands the records back to the producer
+        }
+        if (wroteAny) fflush(stdout); // One flush per batch, on this thread only
+        return wroteAny;
+    }
+
+    void WriterLoop() {
+        while (writerRunning.load(std::memory_order_acquire)) {
+            if (!DrainRings()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(LOG_WRITER_IDLE_MS));
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Logger Implementation
+//----------------------------------------------------------------------------------
+void LogStart() {
+    if (writerRunning.exchange(true)) return;
+    writerThread = std::thread(WriterLoop);
+}
+
+void LogStop() {
+    if (!writerRunning.exchange(false)) return;
+    writerThread.join();
+    DrainRings(); // Whatever was logged while the writer was shutting down
+
+    unsigned long long dropped = droppedCount.load();
+    if (dropped > 0) fprintf(stdout, "[logger] %llu messages dropped (ring full)\n", dropped);
+}
+
+void LogSetCategoryEnabled(LogCategory category, bool enabled) {
+    unsigned int bit = 1u << (int)category;
+    if (enabled) enabledCategories.fetch_or(bit);
+    else enabledCategories.fetch_and(~bit);
+}
+
+bool LogIsCategoryEnabled(LogCategory category) {
+    return (enabledCategories.load(std::memory_order_relaxed) & (1u << (int)category)) != 0;
+}
+
+unsigned long long LogGetDroppedCount() {
+    return droppedCount.load();
+}
+
+void LogWrite(LogLevel level, LogCategory category, const char* format, ...) {
+    if (!LogIsCategoryEnabled(category)) return;
+
+    LogRing* ring = GetThreadRing();
+    unsigned int tail = ring->tail.load(std::memory_order_relaxed);
+    unsigned int head = ring->head.load(std::memory_order_acquire);
+    if (tail - head >= (unsigned int)LOG_RING_SIZE) {
+        droppedCount.fetch_add(1, std::memory_order_relaxed); // Never wait for the writer
+        return;
+    }
+
+    // Format in place, the record is only published once it is complete
+    LogRecord& record = ring->records[tail & (LOG_RING_SIZE - 1)];
+    record.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    record.level = level;
+    record.category = category;
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(record.text, sizeof(record.text), format, args);
+    va_end(args);
+
+    ring->tail.store(tail + 1, std::memory_order_release);
+}
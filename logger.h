@@ -0,0 +1,73 @@
+// logger.h
+#ifndef LOGGER_H
+#define LOGGER_H
+
+//----------------------------------------------------------------------------------
+// Logger
+// Game code formats a message straight into a ring buffer owned by the calling
+// thread (single producer, single consumer, no locks) and returns. A background
+// writer thread drains every ring and does the actual console output, so a log
+// line never flushes or blocks inside the frame. When a ring is full the
+// message is dropped and counted instead of waiting for the writer.
+//
+// Use the GAME_LOG_* macros: levels below GAME_LOG_MIN_LEVEL compile to nothing,
+// arguments included. Categories can additionally be muted at runtime.
+//----------------------------------------------------------------------------------
+enum class LogLevel {
+    VERBOSE,
+    INFO,
+    WARNING,
+    CRITICAL
+};
+
+enum class LogCategory {
+    GAMEPLAY,
+    UI,
+    AUDIO,
+    ASSETS,
+    COUNT
+};
+
+// Lowest level compiled in: 0 VERBOSE, 1 INFO, 2 WARNING, 3 CRITICAL, 4 nothing
+#ifndef GAME_LOG_MIN_LEVEL
+#define GAME_LOG_MIN_LEVEL 1
+#endif
+
+// Starts the writer thread. Messages logged before this wait in their ring.
+void LogStart();
+// Drains everything still queued and stops the writer thread
+void LogStop();
+
+void LogSetCategoryEnabled(LogCategory category, bool enabled);
+bool LogIsCategoryEnabled(LogCategory category);
+// Messages lost because their thread's ring was full
+unsigned long long LogGetDroppedCount();
+
+// printf-style, prefer the macros below so disabled levels cost nothing
+void LogWrite(LogLevel level, LogCategory category, const char* format, ...);
+
+#if GAME_LOG_MIN_LEVEL <= 0
+#define GAME_LOG_VERBOSE(category, ...) LogWrite(LogLevel::VERBOSE, category, __VA_ARGS__)
+#else
+#define GAME_LOG_VERBOSE(category, ...) ((void)0)
+#endif
+
+#if GAME_LOG_MIN_LEVEL <= 1
+#define GAME_LOG_INFO(category, ...) LogWrite(LogLevel::INFO, category, __VA_ARGS__)
+#else
+#define GAME_LOG_INFO(category, ...) ((void)0)
+#endif
+
+#if GAME_LOG_MIN_LEVEL <= 2
+#define GAME_LOG_WARNING(category, ...) LogWrite(LogLevel::WARNING, category, __VA_ARGS__)
+#else
+#define GAME_LOG_WARNING(category, ...) ((void)0)
+#endif
+
+#if GAME_LOG_MIN_LEVEL <= 3
+#define GAME_LOG_CRITICAL(category, ...) LogWrite(LogLevel::CRITICAL, category, __VA_ARGS__)
+#else
+#define GAME_LOG_CRITICAL(category, ...) ((void)0)
+#endif
+
+#endif // LOGGER_H
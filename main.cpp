@@ -1,17 +1,32 @@
 #include "raylib.h"
 #include <vector>
-#include <iostream>
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <cstring>
+#include <cstdlib>
 
 // Include headers
 #include "game_state.h"
-#include "projectile.h"
 #include "plant.h"
-#include "zombie.h"
 #include "game_constants.h"
-#include "lawnmower.h"
+#include "logger.h"
+#include "archetypes.h"
+#include "sim_events.h"
+#include "audio_cues.h"
+#include "simulation.h"
+#include "sim_thread.h"
+#include "render_snapshot.h"
+#include "texture_atlas.h"
+#include "sprite_batch.h"
+#include "hud_layer.h"
+#include "text_cache.h"
+#include "horde_renderer.h"
+#include "ui_layout.h"
+#include "render_device.h"
+#include "asset_loader.h"
+#include "asset_archive.h"
+#include "asset_manifest.h"
 
 // Game Constants
 const int SCREEN_WIDTH = 1280;
@@ -30,521 +45,390 @@ const int PAUSE_BUTTON_SIZE = 60;
 const int PLANT_ICON_SIZE = 70;
 const int PLANT_ICON_SPACING = 20;
 
+// Seed bar, left to right: one selection widget and one HUD icon per entry
+const PlantType SEED_BAR[] = {
+    PlantType::PEASHOOTER,
+    PlantType::SUNFLOWER,
+    PlantType::CHERRY_BOMB,
+    PlantType::WALNUT,
+    PlantType::SHOVEL,
+    PlantType::REPEATER,
+    PlantType::ICE_PEA
+};
+const int SEED_BAR_SIZE = sizeof(SEED_BAR) / sizeof(SEED_BAR[0]);
+static_assert(SEED_BAR_SIZE <= HUD_MAX_ICONS, "The HUD has room for HUD_MAX_ICONS icons");
+
 // Global Variables
-int sunCurrency = 50;
+// Sun, score and level belong to the simulation thread, the UI reads them from the latest RenderSnapshot
 PlantType currentSelectedPlantType = PlantType::PEASHOOTER;
-int score = 0;
-int currentLevel = 1;
-int targetScore = 1000;
+int resetsRequested = 0; // RESET_LEVEL commands sent, compared with RenderSnapshot::generation
 
 Music backgroundMusic;
 bool isMusicMuted = false;
 const float ORIGINAL_MUSIC_VOLUME = 0.5f;
-int CalculateTargetScore(int level) {
-    return level == 1 ? 1000 : 1000 + (level - 1) * 3000;
+
+// --headless[=FRAMES] runs without a window on the software renderer, straight into level 1,
+// for FRAMES frames of 1/60 s each. The simulation steps in lockstep with the frames from a
+// fixed random seed, so two runs capture the same frames. --capture=DIR saves every
+// --capture-every'th frame there, as PNG or with --capture-format=raw as raw RGBA8.
+// --stress adds the stress horde.
+struct LaunchOptions {
+    bool headless = false;
+    int headlessFrames = 600;
+    const char* captureDir = nullptr;
+    int captureEvery = 60;
+    const char* captureExtension = "png";
+    bool stress = false;
+};
+const float HEADLESS_FRAME_TIME = 1.0f / 60.0f;
+const int HEADLESS_TICKS_PER_FRAME = (int)(HEADLESS_FRAME_TIME / SIM_TICK_INTERVAL + 0.5f);
+const unsigned int HEADLESS_RANDOM_SEED = 1;
+
+// Restarts 'level' on the simulation thread. The plant selection is UI state, so it resets here.
+void ResetGame(SimThread& simThread, int levelToSet, bool run)
+{
+    simThread.PushCommand({ SimCommandType::RESET_LEVEL, 0, 0, PlantType::NONE, levelToSet });
+    ++resetsRequested;
+    if (run) {
+        simThread.PushCommand({ SimCommandType::SET_RUNNING, 0, 0, PlantType::NONE, 1 });
+    }
+    currentSelectedPlantType = PlantType::PEASHOOTER;
 }
 
-void ResetGame(std::vector<std::unique_ptr<Plant>>& plants,
-              std::vector<std::unique_ptr<Zombie>>& zombies,
-              std::vector<std::unique_ptr<Projectile>>& projectiles,
-              std::vector<std::unique_ptr<LawnMower>>& lawnmowers,
-              Texture2D lawnmowerTex,
-              Texture2D regularZombieTex,
-              Texture2D jumpingZombieTex,
-              float& zombieSpawnTimer,
-              float& zombieSpawnRate,
-              int& sunCurrency_ref,
-              int& score_ref,
-              PlantType& currentSelectedPlantType_ref,
-              int levelToSet)
+LaunchOptions ParseLaunchOptions(int argc, char** argv)
 {
-    plants.clear();
-    zombies.clear();
-    projectiles.clear();
-    lawnmowers.clear();
-
-    for (int i = 0; i < GRID_ROWS; ++i) {
-        Rectangle mowerRect = {
-            (float)GRID_START_X - TILE_SIZE,
-            (float)GRID_START_Y + i * TILE_SIZE,
-            TILE_SIZE / 2.0f * 1.8f,
-            TILE_SIZE / 2.0f * 1.8f
-        };
-        lawnmowers.push_back(std::make_unique<LawnMower>(mowerRect, i, lawnmowerTex));
+    LaunchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "--headless") == 0) options.headless = true;
+        else if (strncmp(arg, "--headless=", 11) == 0) { options.headless = true; options.headlessFrames = atoi(arg + 11); }
+        else if (strncmp(arg, "--capture=", 10) == 0) options.captureDir = arg + 10;
+        else if (strncmp(arg, "--capture-every=", 16) == 0) options.captureEvery = std::max(1, atoi(arg + 16));
+        else if (strcmp(arg, "--capture-format=raw") == 0) options.captureExtension = "raw";
+        else if (strcmp(arg, "--stress") == 0) options.stress = true;
+        else GAME_LOG_WARNING(LogCategory::UI, "Unknown option %s", arg);
     }
+    return options;
+}
 
-    zombieSpawnTimer = 0.0f;
-    sunCurrency_ref = 50;
-    score_ref = 0;
-    currentSelectedPlantType_ref = PlantType::PEASHOOTER;
-    currentLevel = levelToSet;
-    targetScore = CalculateTargetScore(currentLevel);
-
-    zombieSpawnRate = 5.0f - (currentLevel - 1) * 0.4f;
-    if (zombieSpawnRate < 1.0f) zombieSpawnRate = 1.0f;
-
-    int initialZombies = currentLevel * 2;
-    if (initialZombies > 10) initialZombies = 10;
-
-    for (int i = 0; i < initialZombies; ++i) {
-        int spawnRow = GetRandomValue(0, GRID_ROWS - 1);
-        Rectangle zombieRect = {
-            (float)SCREEN_WIDTH + i * TILE_SIZE,
-            (float)GRID_START_Y + spawnRow * TILE_SIZE + (TILE_SIZE / 4.0f),
-            TILE_SIZE / 2.0f * 2.8f,
-            TILE_SIZE / 2.0f * 2.8f
-        };
-        
-        // Fix for the unique_ptr type mismatch error
-        std::unique_ptr<Zombie> newZombie;
-        if (GetRandomValue(0, 1) == 0) {
-            newZombie = std::make_unique<RegularZombie>(zombieRect, spawnRow, regularZombieTex, currentLevel);
-        } else {
-            newZombie = std::make_unique<JumpingZombie>(zombieRect, spawnRow, jumpingZombieTex, currentLevel);
-        }
-            
-        zombies.push_back(std::move(newZombie));
+// Shown while the loader threads decode, drawn with the default font only
+void DrawLoadingScreen(const AssetLoader& loader)
+{
+    const Rectangle bar = { SCREEN_WIDTH / 2 - 300, SCREEN_HEIGHT / 2 - 15, 600, 30 };
+    RenderBeginFrame();
+        RenderClear(DARKGRAY);
+        RenderText(TextFormat("Loading... %d / %d", loader.GetFinishedCount(), loader.GetCount()), (int)bar.x, (int)bar.y - 40, 30, RAYWHITE);
+        RenderRect(bar, BLACK);
+        RenderRect((Rectangle){ bar.x, bar.y, bar.width * loader.GetProgress(), bar.height }, GREEN);
+        RenderRectLines(bar, 2.0f, RAYWHITE);
+    RenderEndFrame();
+}
+
+// Texture from a decoded image, which is freed
+Texture2D UploadImage(AssetLoader& loader, AssetId id)
+{
+    Image image = loader.TakeImage(id);
+    Texture2D texture = RenderLoadTextureFromImage(image);
+    UnloadImage(image);
+    return texture;
+}
+
+// Queues a snapshot sprite ('source' relative to the sprite) at its lane's depth
+void BatchSprite(SpriteBatch& batch, const TextureAtlas& atlas, const SpriteInstance& sprite)
+{
+    Texture2D texture;
+    Rectangle atlasSource;
+    if (atlas.Resolve(sprite.sprite, sprite.source, texture, atlasSource)) {
+        batch.Add(sprite.layer, sprite.lane, texture, atlasSource, sprite.dest, WHITE);
     }
 }
 
-int main(void)
+int main(int argc, char** argv)
 {
     // Initialization
-    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Plants vs. Zombies - C++/Raylib");
-    InitAudioDevice();
-    backgroundMusic = LoadMusicStream("resources/game_music.mp3");
-    SetMusicVolume(backgroundMusic, ORIGINAL_MUSIC_VOLUME);
-    PlayMusicStream(backgroundMusic);
-    // Load sounds
-    Sound shootSound = LoadSound("resources/shoot.mp3");
-    Sound hitSound = LoadSound("resources/hit.mp3");
-    Sound gameOverSound = LoadSound("resources/gameover.mp3");
-    Sound cherryBombExplosionSound = LoadSound("resources/explosion.mp3");
-    Sound lawnmowerSound = LoadSound("resources/lawnmower.mp3");
-    Sound digSound = LoadSound("resources/dig.mp3");
-    
-
-    // Load textures
-    Texture2D peashooterTex = LoadTexture("resources/peashooter.png");
-    Texture2D sunflowerTex = LoadTexture("resources/sunflower.png");
-    Texture2D cherryBombTex = LoadTexture("resources/cherrybomb.png");
-    Texture2D wallnutTex = LoadTexture("resources/wallnut.png");
-    Texture2D regularZombieTex = LoadTexture("resources/regular_zombie.png");
-    Texture2D jumpingZombieTex = LoadTexture("resources/jumping_zombie.png");
-    Texture2D peaTex = LoadTexture("resources/pea.png");
-    Texture2D grassBackgroundTex = LoadTexture("resources/grass_background.png");
-    Texture2D pauseButtonTex = LoadTexture("resources/pause_button.png");
-    Texture2D mainMenuBackgroundTex = LoadTexture("resources/main_menu_background.png");
-    Texture2D lawnmowerTex = LoadTexture("resources/lawnmower.png");
-    Texture2D levelUpTex = LoadTexture("resources/levelup.png");
-    Texture2D shovelTex = LoadTexture("resources/shovel.png");
-    Texture2D repeaterTex = LoadTexture("resources/repeater.png");
-    Texture2D icePeaPlantTex = LoadTexture("resources/icepea.png");
-    Texture2D icePeaProjectileTex = LoadTexture("resources/pea.png");
-    Texture2D muteIconTex = LoadTexture("resources/mute.png");   
-    Texture2D unmuteIconTex = LoadTexture("resources/unmute.png");
-
-    // Define UI rectangles
-    Rectangle pauseButtonRect = {
-        (float)SCREEN_WIDTH - PAUSE_BUTTON_SIZE - UI_PANEL_PADDING - 40,
-        (float)UI_PANEL_Y + UI_PANEL_PADDING,
-        (float)PAUSE_BUTTON_SIZE,
-        (float)PAUSE_BUTTON_SIZE
-    };
+    LogStart(); // Background log writer, the game thread only queues messages
+    const LaunchOptions options = ParseLaunchOptions(argc, argv);
+    // One mapped archive built by tools/pack_assets; without it every file is opened loose
+    if (!ArchiveOpen(ASSET_ARCHIVE_PATH)) GAME_LOG_INFO(LogCategory::ASSETS, "No asset archive, loading loose files");
+    // Headless runs have no window, no GPU and no audio device; sound cues are never loaded
+    if (options.headless) {
+        RenderDeviceInit(RenderDeviceType::SOFTWARE, SCREEN_WIDTH, SCREEN_HEIGHT);
+    } else {
+        InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Plants vs. Zombies - C++/Raylib");
+        RenderDeviceInit(RenderDeviceType::RAYLIB, SCREEN_WIDTH, SCREEN_HEIGHT);
+        SetTargetFPS(60);
+        InitAudioDevice();
+        backgroundMusic = ArchiveLoadMusicStream(MUSIC_SOURCE);
+        SetMusicVolume(backgroundMusic, ORIGINAL_MUSIC_VOLUME);
+    }
+
+    // Load assets
+    // Images and sounds are decoded on loader threads while the window shows their progress,
+    // only the uploads below run here. Every lawn and HUD sprite lives in the atlas, prebuilt
+    // by tools/pack_atlas or packed at startup; full-screen images stay separate textures,
+    // cached at the size they are drawn at.
+    TextureAtlas atlas;
+    AssetLoader loader;
+    const AssetId atlasImport = loader.AddTask("atlas", [&atlas] { return atlas.Import(ATLAS_TABLE_PATH); });
+    const AssetId grassBackgroundImage = loader.AddImage(BACKGROUND_SOURCES[(int)BackgroundId::GRASS],
+                                                        GRID_COLS * TILE_SIZE, GRID_ROWS * TILE_SIZE);
+    const AssetId mainMenuBackgroundImage = loader.AddImage(BACKGROUND_SOURCES[(int)BackgroundId::MAIN_MENU],
+                                                           SCREEN_WIDTH, SCREEN_HEIGHT);
+    const AssetId levelUpImage = loader.AddImage(BACKGROUND_SOURCES[(int)BackgroundId::LEVEL_UP]);
+    const int soundCount = options.headless ? 0 : SOUND_SOURCE_COUNT;
+    AssetId soundWaves[SOUND_SOURCE_COUNT];
+    for (int i = 0; i < soundCount; ++i) soundWaves[i] = loader.AddWave(SOUND_SOURCES[i].fileName);
+    loader.Start();
+    while (!options.headless && !loader.IsFinished() && !WindowShouldClose()) {
+        DrawLoadingScreen(loader);
+    }
+    loader.Wait();
+
+    // No current exported atlas: every sprite is decoded on its own loader thread, then packed here
+    if (!loader.Succeeded(atlasImport)) {
+        AssetLoader spriteLoader;
+        for (int i = 0; i < (int)SpriteId::COUNT; ++i) {
+            spriteLoader.AddTask(SPRITE_SOURCES[i].name, [&atlas, i] { return atlas.LoadSprite((SpriteId)i); });
+        }
+        spriteLoader.Start();
+        while (!options.headless && !spriteLoader.IsFinished() && !WindowShouldClose()) {
+            DrawLoadingScreen(spriteLoader);
+        }
+        spriteLoader.Wait();
+        atlas.PackLoaded(ATLAS_PAGE_SIZE);
+    }
 
-    // New mute button rectangle - adjust position as desired!
-    Rectangle muteButtonRect = {
-        pauseButtonRect.x - PAUSE_BUTTON_SIZE - UI_PANEL_PADDING, // Place it to the left of pause button
+    atlas.Upload();
+    Texture2D grassBackgroundTex = UploadImage(loader, grassBackgroundImage);
+    Texture2D mainMenuBackgroundTex = UploadImage(loader, mainMenuBackgroundImage);
+    Texture2D levelUpTex = UploadImage(loader, levelUpImage);
+    AudioCues audioCues;
+    for (int i = 0; i < soundCount; ++i) {
+        Wave wave = loader.TakeWave(soundWaves[i]);
+        audioCues.Load(SOUND_SOURCES[i].cue, wave, SOUND_SOURCES[i].maxVoices);
+        UnloadWave(wave);
+    }
+    // Only now: the loading screen and the uploads never call UpdateMusicStream, the main loop does
+    if (!options.headless) PlayMusicStream(backgroundMusic);
+
+    // Menu and overlay text is laid out here once; the runs showing a number follow it when it changes
+    TextCache textCache;
+    const TextRunId playLabel = textCache.Add("PLAY", 40);
+    const TextRunId exitLabel = textCache.Add("EXIT", 40);
+    const TextRunId continueLabel = textCache.Add("CONTINUE", 30);
+    const TextRunId mainMenuLabel = textCache.Add("MAIN MENU", 30);
+    const TextRunId replayLabel = textCache.Add("REPLAY", 30);
+    const TextRunId gameOverLabel = textCache.Add("GAME OVER!", 80);
+    const TextRunId yourScoreLabel = textCache.Add("Your Score: ", 40);
+    const TextRunId restartHintLabel = textCache.Add("Press 'R' to Restart or 'Q' to Quit", 30);
+    const TextRunId pausedLabel = textCache.Add("PAUSED", 80);
+    const TextRunId resumeLabel = textCache.Add("RESUME", 30);
+    const TextRunId levelCompleteText = textCache.Add("", 60);
+    const TextRunId nextTargetText = textCache.Add("", 30);
+    const TextRunId finalScoreText = textCache.Add("", 40);
+
+    // Every clickable widget of every screen: the same rows are drawn and hit-tested
+    const Rectangle lawnRect = { (float)GRID_START_X, (float)GRID_START_Y, (float)(GRID_COLS * TILE_SIZE), (float)(GRID_ROWS * TILE_SIZE) };
+    const Rectangle pauseButtonRect = {
+        (float)SCREEN_WIDTH - PAUSE_BUTTON_SIZE - UI_PANEL_PADDING - 40,
         (float)UI_PANEL_Y + UI_PANEL_PADDING,
         (float)PAUSE_BUTTON_SIZE,
         (float)PAUSE_BUTTON_SIZE
     };
-    Rectangle pauseButtonRect = {
-        (float)SCREEN_WIDTH - PAUSE_BUTTON_SIZE - UI_PANEL_PADDING - 40,
+    const Rectangle muteButtonRect = {
+        pauseButtonRect.x - PAUSE_BUTTON_SIZE - UI_PANEL_PADDING, // Left of the pause button
         (float)UI_PANEL_Y + UI_PANEL_PADDING,
         (float)PAUSE_BUTTON_SIZE,
         (float)PAUSE_BUTTON_SIZE
     };
 
-    Rectangle peashooterIconRect = {
-        (float)UI_PANEL_PADDING + 400,
-        (float)UI_PANEL_Y + UI_PANEL_PADDING,
-        (float)PLANT_ICON_SIZE,
-        (float)PLANT_ICON_SIZE
-    };
-
-    Rectangle sunflowerIconRect = {
-        peashooterIconRect.x + PLANT_ICON_SIZE + PLANT_ICON_SPACING,
-        (float)UI_PANEL_Y + UI_PANEL_PADDING,
-        (float)PLANT_ICON_SIZE,
-        (float)PLANT_ICON_SIZE
-    };
-
-    Rectangle cherryBombIconRect = {
-        sunflowerIconRect.x + PLANT_ICON_SIZE + PLANT_ICON_SPACING,
-        (float)UI_PANEL_Y + UI_PANEL_PADDING,
-        (float)PLANT_ICON_SIZE,
-        (float)PLANT_ICON_SIZE
-    };
-
-    Rectangle wallnutIconRect = {
-        cherryBombIconRect.x + PLANT_ICON_SIZE + PLANT_ICON_SPACING,
-        (float)UI_PANEL_Y + UI_PANEL_PADDING,
-        (float)PLANT_ICON_SIZE,
-        (float)PLANT_ICON_SIZE
-    };
-
-    Rectangle shovelIconRect = {
-        wallnutIconRect.x + PLANT_ICON_SIZE + PLANT_ICON_SPACING,
-        (float)UI_PANEL_Y + UI_PANEL_PADDING,
-        (float)PLANT_ICON_SIZE,
-        (float)PLANT_ICON_SIZE
-    };
-
-    Rectangle repeaterIconRect = {
-        shovelIconRect.x + PLANT_ICON_SIZE + PLANT_ICON_SPACING,
-        (float)UI_PANEL_Y + UI_PANEL_PADDING,
-        (float)PLANT_ICON_SIZE,
-        (float)PLANT_ICON_SIZE
-    };
-
-    Rectangle icePeaIconRect = {
-        repeaterIconRect.x + PLANT_ICON_SIZE + PLANT_ICON_SPACING,
-        (float)UI_PANEL_Y + UI_PANEL_PADDING,
-        (float)PLANT_ICON_SIZE,
-        (float)PLANT_ICON_SIZE
-    };
-
-    Rectangle continueButtonRect = { SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 50, 200, 50 };
-    Rectangle levelMainMenuButtonRect = { SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 110, 200, 50 };
-    Rectangle replayLevelButtonRect = { SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 170, 200, 50 };
+    UiLayout ui;
+    ui.Add({ MAIN_MENU, UiAction::PLAY, { 250, SCREEN_HEIGHT / 2 - 80, 300, 100 }, PlantType::NONE, BLANK, playLabel, BLANK });
+    ui.Add({ MAIN_MENU, UiAction::EXIT, { 950, SCREEN_HEIGHT / 2 + 250, 300, 100 }, PlantType::NONE, RED, exitLabel, BLACK });
+    // Gameplay widgets are drawn by the HUD layer and the lawn, not as buttons
+    ui.Add({ GAMEPLAY, UiAction::PAUSE, pauseButtonRect, PlantType::NONE, BLANK, -1, BLANK });
+    ui.Add({ GAMEPLAY, UiAction::TOGGLE_MUTE, muteButtonRect, PlantType::NONE, BLANK, -1, BLANK });
+    for (int i = 0; i < SEED_BAR_SIZE; ++i) {
+        Rectangle iconRect = {
+            (float)UI_PANEL_PADDING + 400 + i * (PLANT_ICON_SIZE + PLANT_ICON_SPACING),
+            (float)UI_PANEL_Y + UI_PANEL_PADDING,
+            (float)PLANT_ICON_SIZE,
+            (float)PLANT_ICON_SIZE
+        };
+        ui.Add({ GAMEPLAY, UiAction::SELECT_PLANT, iconRect, SEED_BAR[i], BLANK, -1, BLANK });
+    }
+    ui.Add({ GAMEPLAY, UiAction::LAWN, lawnRect, PlantType::NONE, BLANK, -1, BLANK });
+    ui.Add({ PAUSED, UiAction::RESUME, { SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 50, 200, 50 }, PlantType::NONE, LIGHTGRAY, resumeLabel, BLACK });
+    ui.Add({ PAUSED, UiAction::MAIN_MENU, { SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 20, 200, 50 }, PlantType::NONE, GRAY, mainMenuLabel, BLACK });
+    ui.Add({ LEVEL_UP_SCREEN, UiAction::CONTINUE, { SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 50, 200, 50 }, PlantType::NONE, GREEN, continueLabel, BLACK });
+    ui.Add({ LEVEL_UP_SCREEN, UiAction::MAIN_MENU, { SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 110, 200, 50 }, PlantType::NONE, GRAY, mainMenuLabel, BLACK });
+    ui.Add({ LEVEL_UP_SCREEN, UiAction::REPLAY, { SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 170, 200, 50 }, PlantType::NONE, BLUE, replayLabel, BLACK });
+    ui.Build(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    // Game objects live on the simulation thread, they only get sprite-sized texture views
+    SimTextures simTextures = {};
+    for (int type = 0; type < (int)PlantType::NONE; ++type) {
+        simTextures.plants[type] = atlas.GetSpriteTexture(GetPlantArchetype((PlantType)type).sprite);
+    }
+    simTextures.regularZombie = atlas.GetSpriteTexture(GetZombieArchetype(ZombieType::REGULAR).sprite);
+    simTextures.jumpingZombie = atlas.GetSpriteTexture(GetZombieArchetype(ZombieType::JUMPING).sprite);
+    simTextures.lawnmower = atlas.GetSpriteTexture(SpriteId::LAWNMOWER);
+    simTextures.projectiles[(int)ProjectileType::NORMAL] = atlas.GetSpriteTexture(GetProjectileArchetype(ProjectileType::NORMAL).sprite);
+    simTextures.projectiles[(int)ProjectileType::FROZEN] = atlas.GetSpriteTexture(GetProjectileArchetype(ProjectileType::FROZEN).sprite);
+    Simulation simulation(simTextures);
+    SimThread simThread(simulation);
+    SpriteBatch spriteBatch; // Lawn sprites, a few draw calls per frame
+
+    // Panel, lawn background and plant icons are composited once and repainted only when a value changes
+    HudLayout hudLayout = {};
+    hudLayout.panel = (Rectangle){ 0, (float)UI_PANEL_Y, (float)SCREEN_WIDTH, (float)UI_PANEL_HEIGHT };
+    hudLayout.panelColor = CLITERAL(Color){ 50, 50, 50, 255 };
+    hudLayout.lawn = lawnRect;
+    hudLayout.textOrigin = (Vector2){ (float)UI_PANEL_PADDING, (float)(UI_PANEL_Y + UI_PANEL_PADDING) };
+    for (int i = 0; i < ui.GetCount(); ++i) { // Icons sit exactly where their widgets are hit-tested
+        const UiWidget& widget = ui.Get(i);
+        if (widget.action == UiAction::SELECT_PLANT) hudLayout.icons[hudLayout.iconCount++] = { widget.plant, widget.rect };
+    }
+    hudLayout.pauseButton = pauseButtonRect;
+    hudLayout.muteButton = muteButtonRect;
+    HudLayer hudLayer(hudLayout, atlas, grassBackgroundTex);
+    hudLayer.Load(SCREEN_WIDTH, SCREEN_HEIGHT);
 
-    // Game objects
-    std::vector<std::unique_ptr<Plant>> plants;
-    std::vector<std::unique_ptr<Zombie>> zombies;
-    std::vector<std::unique_ptr<Projectile>> projectiles;
-    std::vector<std::unique_ptr<LawnMower>> lawnmowers;
+    // Stress mode: F9 toggles a horde of STRESS_HORDE_SIZE zombies drawn on top of the game,
+    // F10 switches it between GPU instancing and the CPU batch
+    HordeRenderer hordeRenderer;
+    hordeRenderer.Load();
+    StressHorde stressHorde;
 
     // Game state
-    float zombieSpawnTimer = 0.0f;
-    float zombieSpawnRate = 5.0f;
     GameState currentGameState = MAIN_MENU;
 
-    SetTargetFPS(60);
+    // Ticks at SIM_TICK_INTERVAL from here on, independently of this loop; headless runs step it per frame instead
+    if (!options.headless) simThread.Start();
+    int frame = 0;
+    int framesCaptured = 0;
+    float peakRasterMs = 0.0f;
+    if (options.headless) {
+        SetRandomSeed(HEADLESS_RANDOM_SEED);
+        ResetGame(simThread, 1, true);
+        currentGameState = GAMEPLAY;
+        if (options.stress) stressHorde.Spawn(STRESS_HORDE_SIZE, hudLayout.lawn, GRID_ROWS);
+    }
 
     // Main game loop
-    while (!WindowShouldClose()) {
-        float deltaTime = GetFrameTime();
-        UpdateMusicStream(backgroundMusic);
+    while (options.headless ? frame < options.headlessFrames : !WindowShouldClose()) {
+        if (!options.headless) {
+            UpdateMusicStream(backgroundMusic);
+            simThread.FlushCommands(); // Anything the full queue held back last frame
+        } else {
+            simThread.Step(HEADLESS_TICKS_PER_FRAME);
+        }
+
+        // Everything below reads this snapshot, never the simulation itself
+        const RenderSnapshot& snapshot = simThread.AcquireSnapshot();
+        bool snapshotCurrent = snapshot.generation == resetsRequested; // Reflects the last reset we asked for
         switch (currentGameState) {
             case MAIN_MENU: {
-                if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                    Vector2 mousePos = GetMousePosition();
-                    Rectangle playButton = { 250, SCREEN_HEIGHT / 2 - 80, 300, 100 };
-                    Rectangle exitButton = { 950, SCREEN_HEIGHT / 2 + 250, 300, 100 };
-
-                    if (CheckCollisionPointRec(mousePos, playButton)) {
-                        ResetGame(plants, zombies, projectiles, lawnmowers, lawnmowerTex,
-                                  regularZombieTex, jumpingZombieTex,
-                                  zombieSpawnTimer, zombieSpawnRate, sunCurrency, score,
-                                  currentSelectedPlantType, 1);
-                        currentGameState = GAMEPLAY;
-                    } else if (CheckCollisionPointRec(mousePos, exitButton)) {
-                        CloseWindow();
-                    }
+                const UiWidget* clicked = IsMouseButtonPressed(MOUSE_LEFT_BUTTON) ? ui.HitTest(MAIN_MENU, GetMousePosition()) : nullptr;
+                if (clicked && clicked->action == UiAction::PLAY) {
+                    ResetGame(simThread, 1, true);
+                    currentGameState = GAMEPLAY;
+                } else if (clicked && clicked->action == UiAction::EXIT) {
+                    CloseWindow();
                 }
                 break;
             }
 
             case GAMEPLAY: {
-                case GAMEPLAY: {
-                    // Input handling
-                    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                        Vector2 mousePos = GetMousePosition();
-    
-                        if (CheckCollisionPointRec(mousePos, pauseButtonRect)) {
-                            currentGameState = PAUSED;
-                        }
-                        // --- NEW MUTE BUTTON LOGIC START ---
-                        else if (CheckCollisionPointRec(mousePos, muteButtonRect)) {
-                            isMusicMuted = !isMusicMuted; // Toggle the mute state
-                            if (isMusicMuted) {
-                                SetMusicVolume(backgroundMusic, 0.0f); // Mute the music
-                            } else {
-                                SetMusicVolume(backgroundMusic, ORIGINAL_MUSIC_VOLUME); // Unmute to original volume
+                // Input handling
+                if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+                    Vector2 mousePos = GetMousePosition();
+                    const UiWidget* clicked = ui.HitTest(GAMEPLAY, mousePos);
+                    if (clicked) {
+                        switch (clicked->action) {
+                            case UiAction::PAUSE:
+                                simThread.PushCommand({ SimCommandType::SET_RUNNING, 0, 0, PlantType::NONE, 0 });
+                                currentGameState = PAUSED;
+                                break;
+                            case UiAction::TOGGLE_MUTE:
+                                isMusicMuted = !isMusicMuted;
+                                SetMusicVolume(backgroundMusic, isMusicMuted ? 0.0f : ORIGINAL_MUSIC_VOLUME);
+                                break;
+                            case UiAction::SELECT_PLANT: {
+                                // The shovel isn't placeable and costs nothing, it can always be picked
+                                const PlantArchetype& archetype = GetPlantArchetype(clicked->plant);
+                                if (!archetype.placeable || snapshot.sunCurrency >= archetype.cost) currentSelectedPlantType = clicked->plant;
+                                else GAME_LOG_INFO(LogCategory::UI, "Not enough sun for %s!", archetype.name);
+                                break;
                             }
-                        }
-                        // --- NEW MUTE BUTTON LOGIC END ---
-                        else if (CheckCollisionPointRec(mousePos, peashooterIconRect)) {
-                            if (sunCurrency >= 50) currentSelectedPlantType = PlantType::PEASHOOTER;
-                            else std::cout << "Not enough sun for Peashooter!" << std::endl;
-                        }
-                        else if (CheckCollisionPointRec(mousePos, sunflowerIconRect)) {
-                            if (sunCurrency >= 25) currentSelectedPlantType = PlantType::SUNFLOWER;
-                            else std::cout << "Not enough sun for Sunflower!" << std::endl;
-                        }
-                        else if (CheckCollisionPointRec(mousePos, cherryBombIconRect)) {
-                            if (sunCurrency >= 50) currentSelectedPlantType = PlantType::CHERRY_BOMB;
-                            else std::cout << "Not enough sun for Cherry Bomb!" << std::endl;
-                        }
-                        else if (CheckCollisionPointRec(mousePos, wallnutIconRect)) {
-                            if (sunCurrency >= 75) currentSelectedPlantType = PlantType::WALNUT;
-                            else std::cout << "Not enough sun for Wall-nut!" << std::endl;
-                        }
-                        else if (CheckCollisionPointRec(mousePos, shovelIconRect)) {
-                            currentSelectedPlantType = PlantType::SHOVEL;
-                        }
-                        else if (CheckCollisionPointRec(mousePos, repeaterIconRect)) {
-                            if (sunCurrency >= 200) currentSelectedPlantType = PlantType::REPEATER;
-                            else std::cout << "Not enough sun for Repeater!" << std::endl;
-                        }
-                        else if (CheckCollisionPointRec(mousePos, icePeaIconRect)) {
-                            if (sunCurrency >= 150) currentSelectedPlantType = PlantType::ICE_PEA;
-                            else std::cout << "Not enough sun for Ice Pea!" << std::endl;
-                        }
-                        else if (CheckCollisionPointRec(mousePos, { (float)GRID_START_X, (float)GRID_START_Y,
-                                                (float)(GRID_COLS * TILE_SIZE), (float)(GRID_ROWS * TILE_SIZE) })) {
-                            int col = (mousePos.x - GRID_START_X) / TILE_SIZE;
-                            int row = (mousePos.y - GRID_START_Y) / TILE_SIZE;
-    
-                            if (currentSelectedPlantType == PlantType::SHOVEL) {
-                                for (int i = plants.size() - 1; i >= 0; --i) {
-                                    if (plants[i]->row == row && plants[i]->col == col) {
-                                        plants.erase(plants.begin() + i);
-                                        PlaySound(digSound); // Make sure digSound is loaded correctly
-                                        break;
-                                    }
-                                }
-                            } else {
-                                bool plantExists = false;
-                                for (const auto& plant : plants) {
-                                    if (plant->row == row && plant->col == col) {
-                                        plantExists = true;
-                                        break;
-                                    }
-                                }
-    
-                                if (!plantExists) {
-                                    std::unique_ptr<Plant> newPlant = nullptr;
-                                    Rectangle plantRect = {
-                                        (float)GRID_START_X + col * TILE_SIZE + (TILE_SIZE / 4.0f),
-                                        (float)GRID_START_Y + row * TILE_SIZE + (TILE_SIZE / 4.0f),
-                                        TILE_SIZE / 2.0f * 1.8f,
-                                        TILE_SIZE / 2.0f * 1.8f
-                                    };
-    
-                                    switch (currentSelectedPlantType) {
-                                        case PlantType::PEASHOOTER:
-                                            if (sunCurrency >= 50) newPlant = std::make_unique<Peashooter>(plantRect, row, col, peashooterTex);
-                                            break;
-                                        case PlantType::SUNFLOWER:
-                                            if (sunCurrency >= 25) newPlant = std::make_unique<Sunflower>(plantRect, row, col, sunflowerTex);
-                                            break;
-                                        case PlantType::CHERRY_BOMB:
-                                            if (sunCurrency >= 50) newPlant = std::make_unique<CherryBomb>(plantRect, row, col, cherryBombTex, cherryBombExplosionSound);
-                                            break;
-                                        case PlantType::WALNUT:
-                                            if (sunCurrency >= 75) newPlant = std::make_unique<WallNut>(plantRect, row, col, wallnutTex);
-                                            break;
-                                        case PlantType::REPEATER:
-                                            if (sunCurrency >= 200) newPlant = std::make_unique<Repeater>(plantRect, row, col, repeaterTex);
-                                            break;
-                                        case PlantType::ICE_PEA:
-                                            if (sunCurrency >= 150) newPlant = std::make_unique<IcePea>(plantRect, row, col, icePeaPlantTex, icePeaProjectileTex);
-                                            break;
-                                        default:
-                                            break;
-                                    }
-    
-                                    if (newPlant) {
-                                        sunCurrency -= newPlant->GetCost();
-                                        plants.push_back(std::move(newPlant));
-                                    }
+                            case UiAction::LAWN: {
+                                int col = (mousePos.x - GRID_START_X) / TILE_SIZE;
+                                int row = (mousePos.y - GRID_START_Y) / TILE_SIZE;
+
+                                // Whether the tile is free and the sun suffices is decided by the simulation
+                                if (currentSelectedPlantType == PlantType::SHOVEL) {
+                                    simThread.PushCommand({ SimCommandType::DIG_PLANT, row, col, PlantType::SHOVEL, 0 });
+                                } else {
+                                    simThread.PushCommand({ SimCommandType::PLACE_PLANT, row, col, currentSelectedPlantType, 0 });
                                 }
+                                break;
                             }
+                            default:
+                                break;
                         }
                     }
-    
-                    // Level completion check
-                    if (score >= targetScore) {
-                        currentGameState = LEVEL_UP_SCREEN;
-                        break;
-                    }
-                // Zombie spawning
-                zombieSpawnTimer += deltaTime;
-                if (zombieSpawnTimer >= zombieSpawnRate) {
-                    zombieSpawnTimer = 0.0f;
-                    int spawnRow = GetRandomValue(0, GRID_ROWS - 1);
-
-                    std::unique_ptr<Zombie> newZombie = nullptr;
-                    Rectangle zombieRect = {
-                        (float)SCREEN_WIDTH,
-                        (float)GRID_START_Y + spawnRow * TILE_SIZE + (TILE_SIZE / 4.0f),
-                        TILE_SIZE / 2.0f * 2.8f,
-                        TILE_SIZE / 2.0f * 2.8f
-                    };
-
-                    // Fix for the unique_ptr type mismatch error
-                    if (GetRandomValue(0, 1) == 0) {
-                        newZombie = std::make_unique<RegularZombie>(zombieRect, spawnRow, regularZombieTex, currentLevel);
-                    } else {
-                        newZombie = std::make_unique<JumpingZombie>(zombieRect, spawnRow, jumpingZombieTex, currentLevel);
-                    }
-
-                    zombies.push_back(std::move(newZombie));
-                }
-
-                // Update plants
-                for (auto& plant : plants) {
-                    if (plant->active) {
-                        plant->Update(deltaTime, zombies, projectiles, sunCurrency, shootSound, peaTex);
-                    }
                 }
 
-                // Update zombies
-                for (int i = zombies.size() - 1; i >= 0; --i) {
-                    zombies[i]->Update(deltaTime, plants);
-
-                    if (zombies[i]->health <= 0 && zombies[i]->active) {
-                        score += zombies[i]->scoreValue;
-                        zombies[i]->active = false;
-                    }
-
-                    if (!zombies[i]->active) {
-                        zombies.erase(zombies.begin() + i);
-                        continue;
-                    }
-
-                    if (zombies[i]->rect.x <= GRID_START_X - TILE_SIZE / 2 && (size_t)zombies[i]->row < lawnmowers.size()) {
-                        LawnMower* mower = lawnmowers[zombies[i]->row].get();
-                        if (mower && !mower->activated) {
-                            mower->activated = true;
-                            PlaySound(lawnmowerSound);
-                        }
-                    }
-
-                    if (zombies[i]->rect.x < GRID_START_X - TILE_SIZE) {
-                        currentGameState = GAME_OVER;
-                        PlaySound(gameOverSound);
-                        break;
-                    }
+                if (IsKeyPressed(KEY_F9)) {
+                    if (stressHorde.IsEmpty()) stressHorde.Spawn(STRESS_HORDE_SIZE, hudLayout.lawn, GRID_ROWS);
+                    else stressHorde.Clear();
+                    GAME_LOG_INFO(LogCategory::UI, "Stress horde: %d zombies", stressHorde.GetCount());
                 }
-
-                if (currentGameState == GAME_OVER) break;
-
-                // Update projectiles
-                for (int p_idx = projectiles.size() - 1; p_idx >= 0; --p_idx) {
-                    projectiles[p_idx]->rect.x += projectiles[p_idx]->speed.x * deltaTime;
-
-                    if (projectiles[p_idx]->rect.x > SCREEN_WIDTH) {
-                        projectiles[p_idx]->active = false;
-                    }
-                    
-                    if (!projectiles[p_idx]->active) {
-                        projectiles.erase(projectiles.begin() + p_idx);
-                        continue;
-                    }
-                    
-                    for (auto& zombie : zombies) {
-                        if (!zombie->active) continue;
-
-                        if (CheckCollisionRecs(projectiles[p_idx]->rect, zombie->rect)) {
-                            // Apply projectile effects based on type
-                            if (projectiles[p_idx]->type == ProjectileType::FROZEN) {
-                                // Slow down zombie, assuming Zombie class has a method for this
-                                zombie->ApplySlowEffect(); 
-                            }
-                            zombie->health -= projectiles[p_idx]->damage; // Use projectile's damage value
-                            projectiles[p_idx]->active = false; // Deactivate projectile after hit
-                            PlaySound(hitSound);
-
-                            if (zombie->health <= 0) { // Only add score if zombie is actually defeated by this projectile
-                                score += zombie->scoreValue;
-                                zombie->active = false; // Mark zombie as inactive
-                            }
-                            break; // Projectile hit one zombie, so it's done
-                        }
-                    }
+                if (IsKeyPressed(KEY_F10)) {
+                    hordeRenderer.SetInstancingEnabled(!hordeRenderer.IsInstanced());
+                    GAME_LOG_INFO(LogCategory::UI, "Stress horde drawn %s", hordeRenderer.IsInstanced() ? "instanced" : "on the CPU");
                 }
+                stressHorde.Update(options.headless ? HEADLESS_FRAME_TIME : GetFrameTime());
 
-                // Update lawnmowers
-                for (auto& mower : lawnmowers) {
-                    if (mower->activated && mower->active) {
-                        mower->Update(deltaTime);
-                        for (auto& zombie : zombies) {
-                            if (zombie->active && mower->row == zombie->row && CheckCollisionRecs(mower->rect, zombie->rect)) {
-                                if (zombie->active) { // Check active again in case it was just deactivated by another mower in the same frame (unlikely but safe)
-                                    score += zombie->scoreValue;
-                                }
-                                zombie->health = 0; // Instantly kill zombie
-                                zombie->active = false;
-                            }
-                        }
-                        if (mower->rect.x > SCREEN_WIDTH + TILE_SIZE) {
-                            mower->active = false;
-                        }
-                    }
+                // The simulation stops itself when the level is won or lost
+                if (snapshotCurrent && snapshot.status == SimStatus::LEVEL_COMPLETE) {
+                    currentGameState = LEVEL_UP_SCREEN;
+                } else if (snapshotCurrent && snapshot.status == SimStatus::GAME_OVER) {
+                    currentGameState = GAME_OVER;
                 }
-
-                // Cleanup inactive plants
-                plants.erase(std::remove_if(plants.begin(), plants.end(), 
-                                [](const std::unique_ptr<Plant>& p){ return !p->active; }), 
-                                plants.end());
-
                 break;
             }
 
             case PAUSED: {
-                if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                    Vector2 mousePos = GetMousePosition();
-                    Rectangle resumeButton = { SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 50, 200, 50 };
-                    Rectangle exitButton = { SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 20, 200, 50 };
-
-                    if (CheckCollisionPointRec(mousePos, resumeButton)) {
-                        currentGameState = GAMEPLAY;
-                    } else if (CheckCollisionPointRec(mousePos, exitButton)) {
-                        ResetGame(plants, zombies, projectiles, lawnmowers, lawnmowerTex,
-                                  regularZombieTex, jumpingZombieTex,
-                                  zombieSpawnTimer, zombieSpawnRate, sunCurrency, score,
-                                  currentSelectedPlantType, 1);
-                        currentGameState = MAIN_MENU;
-                    }
+                const UiWidget* clicked = IsMouseButtonPressed(MOUSE_LEFT_BUTTON) ? ui.HitTest(PAUSED, GetMousePosition()) : nullptr;
+                if (clicked && clicked->action == UiAction::RESUME) {
+                    simThread.PushCommand({ SimCommandType::SET_RUNNING, 0, 0, PlantType::NONE, 1 });
+                    currentGameState = GAMEPLAY;
+                } else if (clicked && clicked->action == UiAction::MAIN_MENU) {
+                    ResetGame(simThread, 1, false);
+                    currentGameState = MAIN_MENU;
                 }
                 break;
             }
 
             case LEVEL_UP_SCREEN: {
-                if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                    Vector2 mousePos = GetMousePosition();
-                    if (CheckCollisionPointRec(mousePos, continueButtonRect)) {
-                        ResetGame(plants, zombies, projectiles, lawnmowers, lawnmowerTex,
-                                  regularZombieTex, jumpingZombieTex,
-                                  zombieSpawnTimer, zombieSpawnRate, sunCurrency, score,
-                                  currentSelectedPlantType, currentLevel + 1);
-                        currentGameState = GAMEPLAY;
-                    } else if (CheckCollisionPointRec(mousePos, levelMainMenuButtonRect)) {
-                        ResetGame(plants, zombies, projectiles, lawnmowers, lawnmowerTex,
-                                  regularZombieTex, jumpingZombieTex,
-                                  zombieSpawnTimer, zombieSpawnRate, sunCurrency, score,
-                                  currentSelectedPlantType, 1);
-                        currentGameState = MAIN_MENU;
-                    } else if (CheckCollisionPointRec(mousePos, replayLevelButtonRect)) {
-                        ResetGame(plants, zombies, projectiles, lawnmowers, lawnmowerTex,
-                                  regularZombieTex, jumpingZombieTex,
-                                  zombieSpawnTimer, zombieSpawnRate, sunCurrency, score,
-                                  currentSelectedPlantType, currentLevel);
-                        currentGameState = GAMEPLAY;
-                    }
+                const UiWidget* clicked = IsMouseButtonPressed(MOUSE_LEFT_BUTTON) ? ui.HitTest(LEVEL_UP_SCREEN, GetMousePosition()) : nullptr;
+                if (clicked && clicked->action == UiAction::CONTINUE) {
+                    ResetGame(simThread, snapshot.level + 1, true);
+                    currentGameState = GAMEPLAY;
+                } else if (clicked && clicked->action == UiAction::MAIN_MENU) {
+                    ResetGame(simThread, 1, false);
+                    currentGameState = MAIN_MENU;
+                } else if (clicked && clicked->action == UiAction::REPLAY) {
+                    ResetGame(simThread, snapshot.level, true);
+                    currentGameState = GAMEPLAY;
                 }
                 break;
             }
 
             case GAME_OVER: {
                 if (IsKeyPressed(KEY_R)) {
-                    ResetGame(plants, zombies, projectiles, lawnmowers, lawnmowerTex,
-                            regularZombieTex, jumpingZombieTex,
-                            zombieSpawnTimer, zombieSpawnRate, sunCurrency, score,
-                            currentSelectedPlantType, 1);
+                    ResetGame(simThread, 1, true);
                     currentGameState = GAMEPLAY;
                 }
                 if (IsKeyPressed(KEY_Q)) {
@@ -554,175 +438,99 @@ int main(void)
             }
         }
 
+        // Presentation side: play what the simulation reported since the last frame, one voice per cue at most
+        SimEvent event;
+        while (simThread.PopEvent(event)) {
+            if (event.type == SimEventType::SOUND_CUE) audioCues.Request(event.cue);
+        }
+        audioCues.Flush();
+
+        // Only the HUD values that changed get repainted into the cached layer
+        hudLayer.SetSun(snapshot.sunCurrency);
+        hudLayer.SetScore(snapshot.score);
+        hudLayer.SetLevel(snapshot.level, snapshot.targetScore);
+        hudLayer.SetSelection(currentSelectedPlantType);
+        hudLayer.SetMuted(isMusicMuted);
+        if (currentGameState == GAMEPLAY) hudLayer.Update();
+
         // Drawing
-        BeginDrawing();
-            ClearBackground(DARKGRAY);
+        RenderBeginFrame();
+            RenderClear(DARKGRAY);
 
             if (currentGameState == MAIN_MENU) {
-                DrawTexturePro(mainMenuBackgroundTex,
-                              (Rectangle){ 0, 0, (float)mainMenuBackgroundTex.width, (float)mainMenuBackgroundTex.height },
-                              (Rectangle){ 0, 0, (float)SCREEN_WIDTH, (float)SCREEN_HEIGHT },
-                              (Vector2){ 0, 0 }, 0.0f, WHITE);
-
-                Rectangle playButton = { 250, SCREEN_HEIGHT / 2 - 80, 300, 100 };
-                DrawRectangleRec(playButton, BLANK);
-                DrawText("PLAY", playButton.x + (playButton.width - MeasureText("PLAY", 40)) / 2, 
-                                 playButton.y + (playButton.height - 40) / 2, 40, BLANK);
-
-                Rectangle exitButton = { 950, SCREEN_HEIGHT / 2 + 250, 300, 100 };
-                DrawRectangleRec(exitButton, RED);
-                DrawText("EXIT", exitButton.x + (exitButton.width - MeasureText("EXIT", 40)) / 2, 
-                                 exitButton.y + (exitButton.height - 40) / 2, 40, BLACK);
+                RenderTexturedRect(mainMenuBackgroundTex,
+                                   (Rectangle){ 0, 0, (float)mainMenuBackgroundTex.width, (float)mainMenuBackgroundTex.height },
+                                   (Rectangle){ 0, 0, (float)SCREEN_WIDTH, (float)SCREEN_HEIGHT },
+                                   WHITE);
+
+                ui.DrawButtons(MAIN_MENU, textCache);
             }
             else if (currentGameState == LEVEL_UP_SCREEN) {
-                DrawTexturePro(grassBackgroundTex,
-                              (Rectangle){ 0, 0, (float)grassBackgroundTex.width, (float)grassBackgroundTex.height },
-                              (Rectangle){ (float)GRID_START_X, (float)GRID_START_Y, 
-                                           (float)(GRID_COLS * TILE_SIZE), (float)(GRID_ROWS * TILE_SIZE) },
-                              (Vector2){ 0, 0 }, 0.0f, WHITE);
-
-                DrawTexturePro(levelUpTex,
-                              (Rectangle){ 0, 0, (float)levelUpTex.width, (float)levelUpTex.height },
-                              (Rectangle){ SCREEN_WIDTH / 2 - levelUpTex.width / 2.0f, 
-                                           SCREEN_HEIGHT / 2 - levelUpTex.height / 2.0f - 100, 
-                                           (float)levelUpTex.width, (float)levelUpTex.height },
-                              (Vector2){ 0, 0 }, 0.0f, WHITE);
-
-                DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.7f));
-
-                std::string levelUpText = "LEVEL " + std::to_string(currentLevel) + " COMPLETE!";
-                DrawText(levelUpText.c_str(), 
-                                 SCREEN_WIDTH / 2 - MeasureText(levelUpText.c_str(), 60) / 2, 
-                                 SCREEN_HEIGHT / 2 - 120, 60, YELLOW);
-
-                std::string nextTargetText = "Next Target: " + std::to_string(CalculateTargetScore(currentLevel + 1)) + " Points";
-                DrawText(nextTargetText.c_str(), 
-                                 SCREEN_WIDTH / 2 - MeasureText(nextTargetText.c_str(), 30) / 2, 
-                                 SCREEN_HEIGHT / 2 - 50, 30, RAYWHITE);
-
-                DrawRectangleRec(continueButtonRect, GREEN);
-                DrawText("CONTINUE", 
-                                 continueButtonRect.x + (continueButtonRect.width - MeasureText("CONTINUE", 30)) / 2, 
-                                 continueButtonRect.y + (continueButtonRect.height - 30) / 2, 30, BLACK);
-
-                DrawRectangleRec(levelMainMenuButtonRect, GRAY);
-                DrawText("MAIN MENU", 
-                                 levelMainMenuButtonRect.x + (levelMainMenuButtonRect.width - MeasureText("MAIN MENU", 30)) / 2, 
-                                 levelMainMenuButtonRect.y + (levelMainMenuButtonRect.height - 30) / 2, 30, BLACK);
-
-                DrawRectangleRec(replayLevelButtonRect, BLUE);
-                DrawText("REPLAY", 
-                                 replayLevelButtonRect.x + (replayLevelButtonRect.width - MeasureText("REPLAY", 30)) / 2, 
-                                 replayLevelButtonRect.y + (replayLevelButtonRect.height - 30) / 2, 30, BLACK);
-            }
-            else {
-                // Draw UI panel
-                DrawRectangle(0, UI_PANEL_Y, SCREEN_WIDTH, UI_PANEL_HEIGHT, CLITERAL(Color){ 50, 50, 50, 255 });
-
-                // Draw lawn background
-                DrawTexturePro(grassBackgroundTex,
-                              (Rectangle){ 0, 0, (float)grassBackgroundTex.width, (float)grassBackgroundTex.height },
-                              (Rectangle){ (float)GRID_START_X, (float)GRID_START_Y, 
-                                           (float)(GRID_COLS * TILE_SIZE), (float)(GRID_ROWS * TILE_SIZE) },
-                              (Vector2){ 0, 0 }, 0.0f, WHITE);
-
-                // Draw game objects
-                if (currentGameState == GAMEPLAY) {
-                    for (const auto& plant : plants) {
-                        plant->Draw();
-                    }
-                    for (const auto& zombie : zombies) {
-                        zombie->Draw();
-                    }
-                    for (const auto& projectile : projectiles) {
-                        if (projectile->active) {
-                            DrawTextureRec(projectile->texture, projectile->sourceRect, 
-                                           {projectile->rect.x, projectile->rect.y}, WHITE);
-                        }
-                    }
-                    for (const auto& mower : lawnmowers) {
-                        mower->Draw();
-                    }
-
-                    // Draw UI elements
-                    std::string sunText = "Sun: $" + std::to_string(sunCurrency);
-                    DrawText(sunText.c_str(), UI_PANEL_PADDING, UI_PANEL_Y + UI_PANEL_PADDING, 20, YELLOW);
-
-                    std::string scoreText = "Score: " + std::to_string(score);
-                    DrawText(scoreText.c_str(), UI_PANEL_PADDING, UI_PANEL_Y + UI_PANEL_PADDING + 25, 20, WHITE);
-
-                    std::string levelInfoText = "Level: " + std::to_string(currentLevel) + " | Target: " + std::to_string(targetScore);
-                    DrawText(levelInfoText.c_str(), UI_PANEL_PADDING, UI_PANEL_Y + UI_PANEL_PADDING + 50, 20, RAYWHITE);
-
-                    // Draw plant selection icons
-                    DrawTextureEx(peashooterTex, (Vector2){peashooterIconRect.x, peashooterIconRect.y}, 
-                                  0.0f, PLANT_ICON_SIZE / (float)peashooterTex.width, WHITE);
-                    DrawText("$50", peashooterIconRect.x, peashooterIconRect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
-                    if (currentSelectedPlantType == PlantType::PEASHOOTER) {
-                        DrawRectangleLinesEx(peashooterIconRect, 3, YELLOW);
-                    }
+                RenderTexturedRect(grassBackgroundTex,
+                                   (Rectangle){ 0, 0, (float)grassBackgroundTex.width, (float)grassBackgroundTex.height },
+                                   lawnRect,
+                                   WHITE);
 
-                    DrawTextureEx(sunflowerTex, (Vector2){sunflowerIconRect.x, sunflowerIconRect.y}, 
-                                  0.0f, PLANT_ICON_SIZE / (float)sunflowerTex.width, WHITE);
-                    DrawText("$25", sunflowerIconRect.x, sunflowerIconRect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
-                    if (currentSelectedPlantType == PlantType::SUNFLOWER) {
-                        DrawRectangleLinesEx(sunflowerIconRect, 3, YELLOW);
-                    }
+                RenderTexturedRect(levelUpTex,
+                                   (Rectangle){ 0, 0, (float)levelUpTex.width, (float)levelUpTex.height },
+                                   (Rectangle){ SCREEN_WIDTH / 2 - levelUpTex.width / 2.0f, 
+                                                SCREEN_HEIGHT / 2 - levelUpTex.height / 2.0f - 100, 
+                                                (float)levelUpTex.width, (float)levelUpTex.height },
+                                   WHITE);
 
-                    DrawTextureEx(cherryBombTex, (Vector2){cherryBombIconRect.x, cherryBombIconRect.y}, 
-                                  0.0f, PLANT_ICON_SIZE / (float)cherryBombTex.width, WHITE);
-                    DrawText("$50", cherryBombIconRect.x, cherryBombIconRect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
-                    if (currentSelectedPlantType == PlantType::CHERRY_BOMB) {
-                        DrawRectangleLinesEx(cherryBombIconRect, 3, YELLOW);
-                    }
+                RenderRect((Rectangle){ 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT }, Fade(BLACK, 0.7f));
 
-                    DrawTextureEx(wallnutTex, (Vector2){wallnutIconRect.x, wallnutIconRect.y}, 
-                                  0.0f, PLANT_ICON_SIZE / (float)wallnutTex.width, WHITE);
-                    DrawText("$75", wallnutIconRect.x, wallnutIconRect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
-                    if (currentSelectedPlantType == PlantType::WALNUT) {
-                        DrawRectangleLinesEx(wallnutIconRect, 3, YELLOW);
-                    }
+                textCache.SetInt(levelCompleteText, "LEVEL %d COMPLETE!", snapshot.level);
+                textCache.DrawCenteredX(levelCompleteText, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 120, YELLOW);
 
-                    DrawTextureEx(shovelTex, (Vector2){shovelIconRect.x, shovelIconRect.y}, 
-                                  0.0f, PLANT_ICON_SIZE / (float)shovelTex.width, WHITE);
-                    DrawText("$0", shovelIconRect.x, shovelIconRect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
-                    if (currentSelectedPlantType == PlantType::SHOVEL) {
-                        DrawRectangleLinesEx(shovelIconRect, 3, YELLOW);
-                    }
+                textCache.SetInt(nextTargetText, "Next Target: %d Points", CalculateTargetScore(snapshot.level + 1));
+                textCache.DrawCenteredX(nextTargetText, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 50, RAYWHITE);
 
-                    DrawTextureEx(repeaterTex, (Vector2){repeaterIconRect.x, repeaterIconRect.y}, 
-                                  0.0f, PLANT_ICON_SIZE / (float)repeaterTex.width, WHITE);
-                    DrawText("$200", repeaterIconRect.x, repeaterIconRect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
-                    if (currentSelectedPlantType == PlantType::REPEATER) {
-                        DrawRectangleLinesEx(repeaterIconRect, 3, YELLOW);
+                ui.DrawButtons(LEVEL_UP_SCREEN, textCache);
+            }
+            else {
+                // Draw game objects
+                if (currentGameState == GAMEPLAY) {
+                    // Panel, lawn background, icons, prices and values in one quad
+                    hudLayer.Draw();
+
+                    // Every lawn sprite goes through the batch, sorted by lane, layer and
+                    // atlas page: one draw call per page
+                    spriteBatch.Begin();
+                    for (const SpriteInstance& sprite : snapshot.sprites) {
+                        BatchSprite(spriteBatch, atlas, sprite);
                     }
-
-                    DrawTextureEx(icePeaPlantTex, (Vector2){icePeaIconRect.x, icePeaIconRect.y}, 
-                                  0.0f, PLANT_ICON_SIZE / (float)icePeaPlantTex.width, WHITE);
-                    DrawText("$150", icePeaIconRect.x, icePeaIconRect.y + PLANT_ICON_SIZE + 5, 15, WHITE);
-                    if (currentSelectedPlantType == PlantType::ICE_PEA) {
-                        DrawRectangleLinesEx(icePeaIconRect, 3, YELLOW);
+                    spriteBatch.End();
+                    GAME_LOG_VERBOSE(LogCategory::UI, "Sprite batch: %d quads, %d draw calls",
+                                     spriteBatch.GetFrameStats().quads, spriteBatch.GetFrameStats().drawCalls);
+                    GAME_LOG_VERBOSE(LogCategory::GAMEPLAY, "Zombies awake %d, dormant %d; sprites drawn %d, culled %d",
+                                     snapshot.lod.awakeZombies, snapshot.lod.dormantZombies,
+                                     snapshot.lod.drawnSprites, snapshot.lod.culledSprites);
+
+                    if (!stressHorde.IsEmpty()) {
+                        hordeRenderer.ResetStats();
+                        for (int sheet = 0; sheet < (int)HordeSheetId::COUNT; ++sheet) {
+                            hordeRenderer.Draw(atlas, HORDE_SHEETS[sheet], stressHorde.GetInstances((HordeSheetId)sheet));
+                        }
+                        GAME_LOG_VERBOSE(LogCategory::UI, "Stress horde: %d zombies, %d draw calls",
+                                         stressHorde.GetCount(), hordeRenderer.GetDrawCalls());
                     }
-
-                    // Draw pause button
-                    DrawTextureRec(pauseButtonTex,
-                                   (Rectangle){ 0, 0, (float)pauseButtonTex.width, (float)pauseButtonTex.height },
-                                   (Vector2){ pauseButtonRect.x, pauseButtonRect.y },
-                                   WHITE);
+                }
+                else {
+                    // The overlays below hide the HUD, only the panel and the lawn show
+                    hudLayer.DrawBackground();
                 }
 
                 // Draw GAME OVER screen
 if (currentGameState == GAME_OVER) {
-    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.7f));
-    DrawText("GAME OVER!", SCREEN_WIDTH / 2 - MeasureText("GAME OVER!", 80) / 2,
-                             SCREEN_HEIGHT / 2 - 80, 80, RED);
+    RenderRect((Rectangle){ 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT }, Fade(BLACK, 0.7f));
+    textCache.DrawCenteredX(gameOverLabel, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 80, RED);
 
     // --- Adjustments for "Your Score:" and actual score ---
-    const char* scoreLabel = "Your Score: ";
-    std::string scoreValueStr = std::to_string(score); // Convert score to string once
+    textCache.SetInt(finalScoreText, "%d", snapshot.score); // Laid out again only when the score changes
 
-    int scoreLabelWidth = MeasureText(scoreLabel, 40);
-    int scoreValueWidth = MeasureText(scoreValueStr.c_str(), 40);
+    int scoreLabelWidth = textCache.GetWidth(yourScoreLabel);
+    int scoreValueWidth = textCache.GetWidth(finalScoreText);
 
     // Desired gap between the label and the score value
     int horizontalGap = 10; // Adjust this value to change the space between "Your Score:" and the number
@@ -735,67 +543,81 @@ if (currentGameState == GAME_OVER) {
     int scoreY = SCREEN_HEIGHT / 2 + 10; // Y-position remains the same
 
     // Draw "Your Score:" text
-    DrawText(scoreLabel, startX, scoreY, 40, WHITE);
+    textCache.Draw(yourScoreLabel, startX, scoreY, WHITE);
 
     // Draw the actual score value, positioned after the label with the desired gap
-    DrawText(scoreValueStr.c_str(), startX + scoreLabelWidth + horizontalGap, scoreY, 40, YELLOW);
+    textCache.Draw(finalScoreText, startX + scoreLabelWidth + horizontalGap, scoreY, YELLOW);
     // --- End of adjustments ---
 
-    DrawText("Press 'R' to Restart or 'Q' to Quit",
-                             SCREEN_WIDTH / 2 - MeasureText("Press 'R' to Restart or 'Q' to Quit", 30) / 2,
-                             SCREEN_HEIGHT / 2 + 80, 30, WHITE);
+    textCache.DrawCenteredX(restartHintLabel, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 80, WHITE);
 }
                 // Draw PAUSED screen
                 if (currentGameState == PAUSED) {
-                    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.7f));
-                    DrawText("PAUSED", SCREEN_WIDTH / 2 - MeasureText("PAUSED", 80) / 2, 
-                                 SCREEN_HEIGHT / 2 - 150, 80, RAYWHITE);
+                    RenderRect((Rectangle){ 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT }, Fade(BLACK, 0.7f));
+                    textCache.DrawCenteredX(pausedLabel, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 - 150, RAYWHITE);
 
-                    Rectangle resumeButton = { SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 50, 200, 50 };
-                    DrawRectangleRec(resumeButton, LIGHTGRAY);
-                    DrawText("RESUME", resumeButton.x + (resumeButton.width - MeasureText("RESUME", 30)) / 2, resumeButton.y + (resumeButton.height - 30) / 2, 30, BLACK);
-
-                    Rectangle exitButton = { SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 20, 200, 50 };
-                    DrawRectangleRec(exitButton, GRAY);
-                    DrawText("MAIN MENU", exitButton.x + (exitButton.width - MeasureText("MAIN MENU", 30)) / 2, exitButton.y + (exitButton.height - 30) / 2, 30, BLACK);
+                    ui.DrawButtons(PAUSED, textCache);
                 }
             }
 
-        EndDrawing();
+        RenderEndFrame();
         //----------------------------------------------------------------------------------
+
+        if (options.headless) {
+            const SoftFrameStats& rasterStats = RenderGetSoftRasterizer()->GetFrameStats();
+            peakRasterMs = std::max(peakRasterMs, rasterStats.rasterMs);
+            GAME_LOG_VERBOSE(LogCategory::UI, "Software raster: %d commands, %d tile replays, %.2f ms",
+                             rasterStats.commands, rasterStats.tileCommands, rasterStats.rasterMs);
+            if (options.captureDir && frame % options.captureEvery == 0) {
+                const char* fileName = TextFormat("%s/frame_%05d.%s", options.captureDir, frame, options.captureExtension);
+                if (RenderSaveFrame(fileName)) ++framesCaptured;
+                else GAME_LOG_WARNING(LogCategory::UI, "Could not write %s", fileName);
+            }
+        }
+        ++frame;
     }
 
     // De-Initialization
     //--------------------------------------------------------------------------------------
+    simThread.Stop(); // Before any texture goes away, the last snapshot still refers to them
+    GAME_LOG_INFO(LogCategory::GAMEPLAY, "Simulation ran %llu ticks, %llu events dropped",
+                  simulation.GetTickCount(), simThread.GetDroppedEventCount());
+    const SimLodStats& lodStats = simulation.GetLodStats();
+    GAME_LOG_INFO(LogCategory::GAMEPLAY, "Zombie updates %llu, skipped while dormant %llu (%llu coarse steps, %llu wake-ups)",
+                  lodStats.zombieUpdates, lodStats.dormantSkips, lodStats.coarseSteps, lodStats.wakeUps);
+    GAME_LOG_INFO(LogCategory::UI, "Sprite batch peak: %d quads, %d draw calls",
+                  spriteBatch.GetPeakStats().quads, spriteBatch.GetPeakStats().drawCalls);
+    GAME_LOG_INFO(LogCategory::UI, "Text runs laid out: %d", textCache.GetLayoutCount());
+    GAME_LOG_INFO(LogCategory::UI, "HUD repaints: background %d, sun %d, score %d, level %d, selection %d",
+                  hudLayer.GetRepaintCount(HudElement::BACKGROUND), hudLayer.GetRepaintCount(HudElement::SUN),
+                  hudLayer.GetRepaintCount(HudElement::SCORE), hudLayer.GetRepaintCount(HudElement::LEVEL),
+                  hudLayer.GetRepaintCount(HudElement::SELECTION));
+    if (options.headless) {
+        GAME_LOG_INFO(LogCategory::UI, "Headless: %d frames, %d captured, peak raster %.2f ms", frame, framesCaptured, peakRasterMs);
+    }
+
     // Unload all loaded sounds
-    UnloadSound(shootSound);
-    UnloadSound(hitSound);
-    UnloadSound(gameOverSound);
-    UnloadSound(cherryBombExplosionSound);
-    UnloadSound(lawnmowerSound);
-    UnloadSound(digSound); 
-    UnloadMusicStream(backgroundMusic);
+    const AudioCueStats& audioStats = audioCues.GetTotalStats();
+    GAME_LOG_INFO(LogCategory::AUDIO, "Cues requested %d, played %d, deduplicated %d, voice-limited %d",
+                  audioStats.requested, audioStats.played, audioStats.deduplicated, audioStats.voiceLimited);
+    audioCues.Unload();
+    if (!options.headless) UnloadMusicStream(backgroundMusic);
 
     // Unload all loaded textures
-    UnloadTexture(peashooterTex);
-    UnloadTexture(sunflowerTex);
-    UnloadTexture(cherryBombTex);
-    UnloadTexture(wallnutTex);
-    UnloadTexture(regularZombieTex);
-    UnloadTexture(jumpingZombieTex);
-    UnloadTexture(peaTex);
-    UnloadTexture(grassBackgroundTex);
-    UnloadTexture(pauseButtonTex);
-    UnloadTexture(mainMenuBackgroundTex);
-    UnloadTexture(lawnmowerTex);
-    UnloadTexture(levelUpTex); 
-    UnloadTexture(shovelTex); 
-    UnloadTexture(repeaterTex);  // Unload repeater texture
-    UnloadTexture(icePeaPlantTex); // Unload ice pea plant texture
-    UnloadTexture(icePeaProjectileTex); // Unload ice pea projectile texture
-
-    CloseAudioDevice();
-    CloseWindow();
+    hordeRenderer.Unload();
+    hudLayer.Unload();
+    atlas.Unload();
+    RenderUnloadTexture(grassBackgroundTex);
+    RenderUnloadTexture(mainMenuBackgroundTex);
+    RenderUnloadTexture(levelUpTex); 
+
+    RenderDeviceShutdown();
+    ArchiveClose(); // The music stream read from it until now
+    if (!options.headless) {
+        CloseAudioDevice();
+        CloseWindow();
+    }
+    LogStop();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,37 @@
+// mapped_file.h
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+
+//----------------------------------------------------------------------------------
+// Mapped File
+// A whole file mapped read-only into memory (mmap, or a file mapping on
+// Windows). Pages are read in by the OS as they are touched, and nothing is
+// copied. Kept free of raylib so windows.h stays out of every other file.
+//----------------------------------------------------------------------------------
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // False if the file is missing or empty
+    bool Open(const char* fileName);
+    void Close();
+
+    bool IsOpen() const { return data != nullptr; }
+    const unsigned char* GetData() const { return data; }
+    size_t GetSize() const { return size; }
+
+private:
+    const unsigned char* data;
+    size_t size;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+#endif // MAPPED_FILE_H
@@ -2,7 +2,10 @@
 #include "plant.h"
 #include "projectile.h" // Needed to create Projectile objects
 #include "zombie.h"     // Needed to interact with Zombie objects
-#include <iostream>     // For debug prints (optional)
+#include "lane_index.h" // Area queries for CherryBomb, lane checks for shooters
+#include "logger.h"     // Gameplay events, written out off the game thread
+#include "archetypes.h" // Costs, health, fire rates and projectile stats
+#include "sim_events.h" // Shots, sounds and deaths are reported, not played
 #include <algorithm>    // For std::max (CherryBomb)
 
 // Defined global grid constants from main.cpp
@@ -13,324 +16,201 @@ extern const int GRID_START_Y;
 extern const int TILE_SIZE;
 extern const int GRID_ROWS;
 extern const int GRID_COLS;
-// extern const float SUNFLOWER_SUN_GENERATION_RATE; // If defined in game_constants.h, include that instead
 
 //----------------------------------------------------------------------------------
 // Base Plant Implementation
 //----------------------------------------------------------------------------------
-Plant::Plant(Rectangle rect, int health, Color color, Texture2D tex, int row, int col, int numFrames, float frameSpeed)
-    : rect(rect), health(health), active(true), color(color), texture(tex),
+Plant::Plant(Rectangle rect, const PlantArchetype& archetype, int row, int col, AnimClipId clip)
+    : rect(rect), health(archetype.health), active(true), color(archetype.color),
       row(row), col(col), // Make sure these match the order in plant.h to avoid -Wreorder
-      currentFrame(0), frameTimer(0.0f), frameSpeed(frameSpeed), numFrames(numFrames)
+      clip(clip), animPhase(0.0f), broadphaseId(-1),
+      archetype(&archetype)
 {
-    // Initialize sourceRect based on total texture width and number of frames
-    sourceRect = {0, 0, (float)texture.width / numFrames, (float)texture.height};
 }
 
-void Plant::Draw() const {
-    if (active) {
-        // Draw the current frame of the plant's animation
-        DrawTexturePro(texture, sourceRect, rect, {0, 0}, 0, WHITE);
-    }
+// The base plant has no deadlines of its own: its animation plays from the simulation clock
+void Plant::Start(TimerWheel&) {
+}
+
+void Plant::OnTimer(TimerKind, SimContext&) {
+}
+
+void Plant::CancelTimers(TimerWheel&) {
+}
+
+int Plant::GetCost() const {
+    return archetype->cost;
 }
 
 //----------------------------------------------------------------------------------
 // Peashooter Implementations
 //----------------------------------------------------------------------------------
-Peashooter::Peashooter(Rectangle rect, int row, int col, Texture2D tex)
-    : Plant(rect, 100, GREEN, tex, row, col, 1, 0.0f), // Assuming 1 frame for peashooter animation, 0 speed
-      fireRate(1.5f), fireTimer(1.5f) { // Fires every 1.5 seconds, starts ready
-    // If your peashooter.png has multiple frames (e.g., idle animation), adjust numFrames and frameSpeed here
-    // Example: Plant(rect, 100, GREEN, tex, row, col, 4, 0.15f) for 4 frames @ 0.15s/frame
+Peashooter::Peashooter(Rectangle rect, int row, int col)
+    : Peashooter(rect, row, col, GetPlantArchetype(PlantType::PEASHOOTER), AnimClipId::PEASHOOTER_IDLE) {
 }
 
-void Peashooter::Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies, std::vector<std::unique_ptr<Projectile>>& projectiles, int& sunCurrency, Sound shootSound, Texture2D peaTex) {
-    if (!active) return;
+Peashooter::Peashooter(Rectangle rect, int row, int col, const PlantArchetype& archetype, AnimClipId clip)
+    : Plant(rect, archetype, row, col, clip),
+      fireTimer() { // Starts ready (see Start)
+    // An idle animation only needs more frames in its ANIM_CLIP_DEFS row (animation.h)
+}
+
+void Peashooter::Start(TimerWheel& timers) {
+    Plant::Start(timers);
+    fireTimer = timers.Schedule(0.0f, TimerKind::PLANT_FIRE, this); // Starts ready to fire
+}
 
-    // Animation update for Peashooter (if it has one)
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        sourceRect.x = currentFrame * sourceRect.width;
+void Peashooter::OnTimer(TimerKind kind, SimContext& ctx) {
+    if (!active) return;
+    if (kind != TimerKind::PLANT_FIRE) {
+        Plant::OnTimer(kind, ctx);
+        return;
     }
 
-    fireTimer += deltaTime;
-    if (fireTimer >= fireRate) {
-        // Check if there is a zombie in the same row before firing
-        bool zombieInLane = false;
-        for (const auto& zombie : zombies) {
-            if (zombie->active && zombie->row == this->row && zombie->rect.x > this->rect.x) {
-                zombieInLane = true;
-                break;
-            }
-        }
-
-        if (zombieInLane) {
-            fireTimer = 0.0f; // Reset timer
-            // Create a new projectile with the pea texture and NORMAL type
-            // Corrected Projectile constructor call
-            std::unique_ptr<Projectile> newProjectile = std::make_unique<Projectile>(
-                (Rectangle){ this->rect.x + this->rect.width, this->rect.y + this->rect.height / 4, 20, 10 },
-                (Vector2){ 300.0f, 0.0f }, // speed
-                50,                        // damage
-                peaTex,                    // texture
-                ProjectileType::NORMAL     // type
-            );
-            projectiles.push_back(std::move(newProjectile)); // Add to projectiles vector
-            PlaySound(shootSound); // Play sound here, passed from main
-        }
+    // Check if there is a zombie in the same row before firing
+    if (ctx.laneIndex.AnyRightOf(this->row, this->rect.x)) {
+        Fire(ctx);
+        fireTimer = ctx.timers.Schedule(archetype->fireRate, TimerKind::PLANT_FIRE, this);
+    } else {
+        // Stays ready, looks again shortly instead of polling every frame
+        fireTimer = ctx.timers.Schedule(SHOOTER_IDLE_RECHECK_INTERVAL, TimerKind::PLANT_FIRE, this);
     }
 }
 
-// Draw method for Peashooter (now required)
-void Peashooter::Draw() const {
-    Plant::Draw(); // Call base class Draw
+void Peashooter::CancelTimers(TimerWheel& timers) {
+    Plant::CancelTimers(timers);
+    timers.Cancel(fireTimer);
+}
+
+void Peashooter::Fire(SimContext& ctx) {
+    const ProjectileArchetype& shot = GetProjectileArchetype(archetype->projectile);
+
+    // Repeaters fire two peas at once, all from the same spot
+    for (int i = 0; i < archetype->projectilesPerShot; ++i) {
+        Projectile newProjectile(
+            (Rectangle){ this->rect.x + this->rect.width, this->rect.y + this->rect.height / 4, shot.width, shot.height },
+            (Vector2){ shot.speed, 0.0f },
+            shot.damage,
+            shot.type
+        );
+        ctx.projectiles.Spawn(this->row, newProjectile); // Add to this plant's lane
+        ctx.events.ProjectileSpawned(this->row, newProjectile.rect.x, newProjectile.rect.y, shot.type);
+    }
+    ctx.events.PlaySoundCue(SoundCue::SHOOT); // Once per shot
 }
 
 //----------------------------------------------------------------------------------
 // Sunflower Implementations
 //----------------------------------------------------------------------------------
-Sunflower::Sunflower(Rectangle rect, int row, int col, Texture2D tex)
-    : Plant(rect, 80, YELLOW, tex, row, col, 1, 0.0f), // Assuming 1 frame for sunflower
-      sunProductionInterval(10.0f), sunProductionTimer(0.0f) { // Example: Produces sun every 10 seconds
-    // You should define SUNFLOWER_SUN_GENERATION_RATE in game_constants.h if you want to use it
-    // For now, I've put a default of 10.0f directly.
-    // Adjust numFrames and frameSpeed if you have an animation for sunflower
+Sunflower::Sunflower(Rectangle rect, int row, int col)
+    : Plant(rect, GetPlantArchetype(PlantType::SUNFLOWER), row, col, AnimClipId::SUNFLOWER_IDLE),
+      sunProductionTimer() { // Interval and amount come from the archetype
 }
 
-void Sunflower::Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies, std::vector<std::unique_ptr<Projectile>>& projectiles, int& sunCurrency, Sound shootSound, Texture2D peaTex) {
-    if (!active) return;
+void Sunflower::Start(TimerWheel& timers) {
+    Plant::Start(timers);
+    sunProductionTimer = timers.Schedule(archetype->sunInterval, TimerKind::SUN_PRODUCTION, this);
+}
 
-    // Animation update for Sunflower (if it has one)
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        sourceRect.x = currentFrame * sourceRect.width;
+void Sunflower::OnTimer(TimerKind kind, SimContext& ctx) {
+    if (!active) return;
+    if (kind != TimerKind::SUN_PRODUCTION) {
+        Plant::OnTimer(kind, ctx);
+        return;
     }
 
-    sunProductionTimer += deltaTime;
-    if (sunProductionTimer >= sunProductionInterval) {
-        sunProductionTimer = 0.0f;
-        sunCurrency += 25; // Produce 25 sun
-        std::cout << "Sunflower produced sun! Current sun: " << sunCurrency << std::endl;
-        // Play a sun production sound if you have one (not included in this sound parameter)
-    }
+    ctx.sunCurrency += archetype->sunAmount;
+    GAME_LOG_INFO(LogCategory::GAMEPLAY, "Sunflower produced sun! Current sun: %d", ctx.sunCurrency);
+    // Play a sun production sound if you have one (not included in this sound parameter)
+    sunProductionTimer = ctx.timers.Schedule(archetype->sunInterval, TimerKind::SUN_PRODUCTION, this);
 }
 
-// Draw method for Sunflower (now required)
-void Sunflower::Draw() const {
-    Plant::Draw(); // Call base class Draw
+void Sunflower::CancelTimers(TimerWheel& timers) {
+    Plant::CancelTimers(timers);
+    timers.Cancel(sunProductionTimer);
 }
 
 //----------------------------------------------------------------------------------
 // CherryBomb Implementations
 //----------------------------------------------------------------------------------
-CherryBomb::CherryBomb(Rectangle rect, int row, int col, Texture2D tex, Sound expSound)
-    : Plant(rect, 1, RED, tex, row, col, 1, 0.0f), // Very low health, just needs to exist until explosion
-      fuseTimer(0.0f), exploded(false), explosionSound(expSound) {
-    // Adjust numFrames and frameSpeed if you have an animation for cherry bomb (e.g., blinking fuse)
+CherryBomb::CherryBomb(Rectangle rect, int row, int col)
+    : Plant(rect, GetPlantArchetype(PlantType::CHERRY_BOMB), row, col, AnimClipId::CHERRY_BOMB_IDLE), // Very low health, just needs to exist until explosion
+      fuseTimer(), exploded(false) {
 }
 
-void CherryBomb::Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies, std::vector<std::unique_ptr<Projectile>>& projectiles, int& sunCurrency, Sound shootSound, Texture2D peaTex) {
-    if (!active || exploded) return;
+void CherryBomb::Start(TimerWheel& timers) {
+    Plant::Start(timers);
+    fuseTimer = timers.Schedule(FUSE_DURATION, TimerKind::CHERRY_FUSE, this);
+}
 
-    // Animation update for CherryBomb (e.g., for a blinking fuse)
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        sourceRect.x = currentFrame * sourceRect.width;
-    }
+void CherryBomb::CancelTimers(TimerWheel& timers) {
+    Plant::CancelTimers(timers);
+    timers.Cancel(fuseTimer);
+}
 
-    fuseTimer += deltaTime;
-    if (fuseTimer >= FUSE_DURATION) {
-        exploded = true;
-        this->active = false; // Cherry Bomb deactivates after exploding
-        PlaySound(explosionSound); // Play explosion sound
-
-        int explosionDamage = 9999; // High damage to instantly kill most zombies
-        // Calculate explosion area (3x3 grid tiles centered on Cherry Bomb)
-        Rectangle explosionArea = {
-            (float)(GRID_START_X + (this->col - 1) * TILE_SIZE),
-            (float)(GRID_START_Y + (this->row - 1) * TILE_SIZE),
-            (float)(TILE_SIZE * 3), // 3 tiles wide
-            (float)(TILE_SIZE * 3)  // 3 tiles high
-        };
-
-        // Clamp explosion area to grid boundaries to prevent out-of-bounds checks
-        // Using `std::max` and `std::min` requires `#include <algorithm>`
-        explosionArea.x = std::max((float)GRID_START_X, explosionArea.x);
-        explosionArea.y = std::max((float)GRID_START_Y, explosionArea.y);
-        explosionArea.width = std::min((float)GRID_COLS * TILE_SIZE - (explosionArea.x - GRID_START_X), explosionArea.width);
-        explosionArea.height = std::min((float)GRID_ROWS * TILE_SIZE - (explosionArea.y - GRID_START_Y), explosionArea.height);
-
-
-        for (auto& zombie : zombies) {
-            if (zombie->active && CheckCollisionRecs(explosionArea, zombie->rect)) {
-                zombie->health -= explosionDamage; // Deal damage
-            }
-        }
-        std::cout << "CherryBomb exploded! Damaged zombies in area." << std::endl;
+void CherryBomb::OnTimer(TimerKind kind, SimContext& ctx) {
+    if (!active || exploded) return;
+    if (kind != TimerKind::CHERRY_FUSE) {
+        Plant::OnTimer(kind, ctx);
+        return;
     }
-}
 
-// Draw method for CherryBomb (now required)
-void CherryBomb::Draw() const {
-    Plant::Draw(); // Call base class Draw
+    exploded = true;
+    this->active = false; // Cherry Bomb deactivates after exploding
+    CancelTimers(ctx.timers);
+    ctx.events.PlaySoundCue(SoundCue::EXPLOSION);
+
+    int explosionDamage = 9999; // High damage to instantly kill most zombies
+    // Calculate explosion area (3x3 grid tiles centered on Cherry Bomb)
+    Rectangle explosionArea = {
+        (float)(GRID_START_X + (this->col - 1) * TILE_SIZE),
+        (float)(GRID_START_Y + (this->row - 1) * TILE_SIZE),
+        (float)(TILE_SIZE * 3), // 3 tiles wide
+        (float)(TILE_SIZE * 3)  // 3 tiles high
+    };
+
+    // Clamp explosion area to grid boundaries to prevent out-of-bounds checks
+    // (rows are clamped by the lane query, only the x range is used from here on)
+    // Using `std::max` and `std::min` requires `#include <algorithm>`
+    explosionArea.x = std::max((float)GRID_START_X, explosionArea.x);
+    explosionArea.y = std::max((float)GRID_START_Y, explosionArea.y);
+    explosionArea.width = std::min((float)GRID_COLS * TILE_SIZE - (explosionArea.x - GRID_START_X), explosionArea.width);
+    explosionArea.height = std::min((float)GRID_ROWS * TILE_SIZE - (explosionArea.y - GRID_START_Y), explosionArea.height);
+
+
+    // Only the zombies in the three covered lanes and inside the x range are visited
+    std::vector<Zombie*> hitZombies;
+    ctx.laneIndex.QueryArea(this->row - 1, this->row + 1,
+                        explosionArea.x, explosionArea.x + explosionArea.width, hitZombies);
+    for (Zombie* zombie : hitZombies) {
+        zombie->health -= explosionDamage; // Deal damage
+    }
+    GAME_LOG_INFO(LogCategory::GAMEPLAY, "CherryBomb exploded! Damaged %d zombies in area.", (int)hitZombies.size());
 }
 
 
 //----------------------------------------------------------------------------------
 // WallNut Implementations
 //----------------------------------------------------------------------------------
-WallNut::WallNut(Rectangle rect, int row, int col, Texture2D tex)
-    : Plant(rect, 400, BROWN, tex, row, col, 1, 0.0f) { // High health, assumes 1 frame for wall-nut
-    // Adjust numFrames and frameSpeed if you have an animation for wall-nut
-}
-
-void WallNut::Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies, std::vector<std::unique_ptr<Projectile>>& projectiles, int& sunCurrency, Sound shootSound, Texture2D peaTex) {
-    if (!active) return;
-    // Animation update for Wall-nut (if it has one)
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        sourceRect.x = currentFrame * sourceRect.width;
-    }
-    // Wall-nuts don't do anything specific in update besides take damage, which is handled by zombie collisions.
-}
-
-// Draw method for WallNut (now required)
-void WallNut::Draw() const {
-    Plant::Draw(); // Call base class Draw
+WallNut::WallNut(Rectangle rect, int row, int col)
+    : Plant(rect, GetPlantArchetype(PlantType::WALNUT), row, col, AnimClipId::WALNUT_IDLE) { // High health, no timers
 }
 
 //----------------------------------------------------------------------------------
 // Repeater Implementations (NEW!)
 //----------------------------------------------------------------------------------
-Repeater::Repeater(Rectangle rect, int row, int col, Texture2D tex)
-    : Peashooter(rect, row, col, tex) // Call base Peashooter constructor
+Repeater::Repeater(Rectangle rect, int row, int col)
+    : Peashooter(rect, row, col, GetPlantArchetype(PlantType::REPEATER), AnimClipId::REPEATER_IDLE)
 {
-    // Repeater's unique properties: fires twice, so faster effective fire rate
-    // We achieve this by overriding the Update logic to create two projectiles.
-    // The fireRate itself can be similar to Peashooter's, but two projectiles are created.
-    // To make it shoot "twice the amount of pea causing twice the damage" per fire event,
-    // we can either make it fire two projectiles or make one projectile deal double damage.
-    // The prompt implies two separate peas, so we will fire two projectiles.
-    this->fireRate = 1.0f; // Slightly faster or same as Peashooter, but produces 2 peas.
-    this->fireTimer = this->fireRate; // Start ready to fire
-    this->health = 100; // Default health (can be adjusted)
-}
-
-void Repeater::Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies, std::vector<std::unique_ptr<Projectile>>& projectiles, int& sunCurrency, Sound shootSound, Texture2D peaTex) {
-    if (!active) return;
-
-    // Animation update (similar to Peashooter)
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        sourceRect.x = currentFrame * sourceRect.width;
-    }
-
-    fireTimer += deltaTime;
-    if (fireTimer >= fireRate) {
-        bool zombieInLane = false;
-        for (const auto& zombie : zombies) {
-            if (zombie->active && zombie->row == this->row && zombie->rect.x > this->rect.x) {
-                zombieInLane = true;
-                break;
-            }
-        }
-
-        if (zombieInLane) {
-            fireTimer = 0.0f; // Reset timer
-
-            // First projectile
-            std::unique_ptr<Projectile> newProjectile1 = std::make_unique<Projectile>(
-                (Rectangle){ this->rect.x + this->rect.width, this->rect.y + this->rect.height / 4, 20, 10 },
-                (Vector2){ 300.0f, 0.0f }, // speed
-                50,                        // damage (standard pea damage)
-                peaTex,                    // texture
-                ProjectileType::NORMAL     // type
-            );
-            projectiles.push_back(std::move(newProjectile1));
-            PlaySound(shootSound);
-
-            // Second projectile (fired immediately after the first for "twice the amount")
-            // You can add a small delay here (e.g., 0.1s) for visual effect if desired.
-            // For true "twice the amount" per fire *event*, immediate is fine.
-            std::unique_ptr<Projectile> newProjectile2 = std::make_unique<Projectile>(
-                (Rectangle){ this->rect.x + this->rect.width, this->rect.y + this->rect.height / 4, 20, 10 },
-                (Vector2){ 300.0f, 0.0f }, // speed
-                50,                        // damage
-                peaTex,                    // texture
-                ProjectileType::NORMAL     // type
-            );
-            projectiles.push_back(std::move(newProjectile2));
-            // PlaySound(shootSound); // Play sound again if you want a double-shot sound, or just once for the "burst"
-        }
-    }
-}
-
-// Draw method for Repeater (now required, can just call base)
-void Repeater::Draw() const {
-    Plant::Draw(); // Call base class Draw
+    // Repeater's unique properties: fires twice per shot and a bit faster.
+    // Both come from its archetype (projectilesPerShot = 2), Peashooter::Fire does the rest.
 }
 
 //----------------------------------------------------------------------------------
 // IcePea Implementations (NEW!)
 //----------------------------------------------------------------------------------
-IcePea::IcePea(Rectangle rect, int row, int col, Texture2D tex, Texture2D icePeaProjTex)
-    : Peashooter(rect, row, col, tex), icePeaProjectileTex(icePeaProjTex) // Call base Peashooter constructor
+IcePea::IcePea(Rectangle rect, int row, int col)
+    : Peashooter(rect, row, col, GetPlantArchetype(PlantType::ICE_PEA), AnimClipId::ICE_PEA_IDLE)
 {
-    // Ice Pea specific properties
-    this->fireRate = 1.8f; // Slightly slower fire rate for slowing effect
-    this->fireTimer = this->fireRate; // Start ready to fire
-    this->health = 200; // Default health (can be adjusted)
-}
-
-void IcePea::Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies, std::vector<std::unique_ptr<Projectile>>& projectiles, int& sunCurrency, Sound shootSound, Texture2D peaTex) {
-    if (!active) return;
-
-    // Animation update (similar to Peashooter)
-    frameTimer += deltaTime;
-    if (frameTimer >= frameSpeed) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % numFrames;
-        sourceRect.x = currentFrame * sourceRect.width;
-    }
-
-    fireTimer += deltaTime;
-    if (fireTimer >= fireRate) {
-        bool zombieInLane = false;
-        for (const auto& zombie : zombies) {
-            if (zombie->active && zombie->row == this->row && zombie->rect.x > this->rect.x) {
-                zombieInLane = true;
-                break;
-            }
-        }
-
-        if (zombieInLane) {
-            fireTimer = 0.0f; // Reset timer
-
-            // Create a FROZEN projectile using the icePeaProjectileTex
-            std::unique_ptr<Projectile> newProjectile = std::make_unique<Projectile>(
-                (Rectangle){ this->rect.x + this->rect.width, this->rect.y + this->rect.height / 4, 20, 10 },
-                (Vector2){ 300.0f, 0.0f }, // speed
-                50,                        // damage (same as normal pea)
-                icePeaProjectileTex,       // Use the specific ice pea projectile texture
-                ProjectileType::FROZEN     // Set type to FROZEN
-            );
-            projectiles.push_back(std::move(newProjectile));
-            PlaySound(shootSound); // You might want a distinct sound for ice peas
-        }
-    }
+    // Ice Pea specific properties (slower fire rate, FROZEN projectiles) come from its archetype
 }
-
-// Draw method for IcePea (now required, can just call base)
-void IcePea::Draw() const {
-    Plant::Draw(); // Call base class Draw
-}
\ No newline at end of file
@@ -5,13 +5,19 @@
 #include "raylib.h"
 #include <vector> // Required for interaction with zombie/projectile vectors
 #include <memory> // Required for std::unique_ptr
+#include "broadphase.h"
+#include "timer_wheel.h"
+#include "sim_context.h"
+#include "animation.h"
 
 
 // Forward declarations to avoid circular dependencies
 // These are needed because Plant methods might interact with Zombies or Projectiles
 // IMPORTANT: These should be 'class' if they are classes, not 'struct' unless they are POD structs.
 class Zombie;
-class Projectile;
+class ProjectileLanes;
+class LaneIndex;
+struct PlantArchetype; // Stats table row, see archetypes.h
 
 
 // Enum to identify different plant types
@@ -35,27 +41,35 @@ public:
     int health;
     bool active;
     Color color; // Fallback or for debugging colors, mostly overridden by texture
-    Texture2D texture; // The sprite/texture for the plant
-    Rectangle sourceRect; // Current frame in the sprite sheet
 
     // Fix for -Wreorder warning: Reorder members to match constructor initialization order
     int row;
     int col; // Added column for more precise grid placement knowledge
 
-    int currentFrame;
-    float frameTimer;
-    float frameSpeed;
-    int numFrames;
+    AnimClipId clip;  // Played from the simulation clock, see animation.h
+    float animPhase;  // Clock value the clip started at
+    int broadphaseId; // Proxy id in the Broadphase, -1 if not registered
+    const PlantArchetype* archetype; // Cost, health and the per-type tunables
 
-    Plant(Rectangle rect, int health, Color color, Texture2D tex, int row, int col, int numFrames, float frameSpeed);
+    // Health and fallback color come from the archetype
+    Plant(Rectangle rect, const PlantArchetype& archetype, int row, int col, AnimClipId clip);
     virtual ~Plant() = default; // Virtual destructor for proper cleanup of derived objects
 
-    // Pure virtual functions - must be implemented by derived classes
-    virtual void Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies, std::vector<std::unique_ptr<Projectile>>& projectiles, int& sunCurrency, Sound shootSound, Texture2D peaTex) = 0;
-    virtual void Draw() const; // Default draw using texture - marked const, and now virtual (was missing `virtual`)
-    virtual int GetCost() const = 0;
+    // Plants have no per-frame update: they register their deadlines with the TimerWheel
+    // once placed (Start) and only run when one of them fires (OnTimer). Anything
+    // audible or visible they cause goes to ctx.events, never to raylib directly.
+    virtual void Start(TimerWheel& timers);
+    virtual void OnTimer(TimerKind kind, SimContext& ctx);
+    virtual void CancelTimers(TimerWheel& timers); // Must be called before the plant is destroyed
+
+    // Drawing happens on the main thread from a RenderSnapshot (see Simulation::WriteSnapshot)
+    int GetCost() const; // Table lookup, no virtual call
     virtual PlantType GetType() const = 0;
 
+    // Broadphase footprint: the plant's x extent, occupying its own lane
+    BroadphaseBounds GetBounds() const { return { rect.x, rect.x + rect.width, row, row }; }
+    static BroadphaseBounds BoundsOf(const void* owner) { return static_cast<const Plant*>(owner)->GetBounds(); }
+
     // Common plant methods (can be overridden but not necessarily pure virtual)
     void TakeDamage(int damage) {
         health -= damage;
@@ -80,56 +94,57 @@ protected: // Changed from private to protected so derived classes can access
 // Peashooter
 class Peashooter : public Plant {
 protected: // Changed from private to protected for derived classes (Repeater, IcePea) to access
-    float fireRate;
-    float fireTimer;
+    TimerHandle fireTimer; // Every archetype->fireRate while there is a zombie in the lane
+
+    // Spawns projectilesPerShot projectiles of the archetype's type, called when the
+    // fire timer expires with a zombie in the lane
+    virtual void Fire(SimContext& ctx);
+
+    // For Repeater and IcePea, which share everything but their table row
+    Peashooter(Rectangle rect, int row, int col, const PlantArchetype& archetype, AnimClipId clip);
 
 public:
-    Peashooter(Rectangle rect, int row, int col, Texture2D tex);
-    void Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies, std::vector<std::unique_ptr<Projectile>>& projectiles, int& sunCurrency, Sound shootSound, Texture2D peaTex) override;
-    void Draw() const override; // Mark as const to match base
-    int GetCost() const override { return 50; } // Cost for Peashooter
+    Peashooter(Rectangle rect, int row, int col);
+    void Start(TimerWheel& timers) override;
+    void OnTimer(TimerKind kind, SimContext& ctx) override;
+    void CancelTimers(TimerWheel& timers) override;
     PlantType GetType() const override { return PlantType::PEASHOOTER; }
 };
 
 // Sunflower
 class Sunflower : public Plant {
 private:
-    float sunProductionInterval; // Time between sun production
-    float sunProductionTimer;    // Timer to track sun production
+    TimerHandle sunProductionTimer; // Next sun production, every archetype->sunInterval
 
 public:
-    Sunflower(Rectangle rect, int row, int col, Texture2D tex);
-    void Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies, std::vector<std::unique_ptr<Projectile>>& projectiles, int& sunCurrency, Sound shootSound, Texture2D peaTex) override;
-    void Draw() const override; // Mark as const to match base
-    int GetCost() const override { return 25; } // Cost for Sunflower
+    Sunflower(Rectangle rect, int row, int col);
+    void Start(TimerWheel& timers) override;
+    void OnTimer(TimerKind kind, SimContext& ctx) override;
+    void CancelTimers(TimerWheel& timers) override;
     PlantType GetType() const override { return PlantType::SUNFLOWER; }
 };
 
 // CherryBomb
 class CherryBomb : public Plant {
 private:
-    float fuseTimer; // Time until explosion
+    TimerHandle fuseTimer; // Explosion, FUSE_DURATION after placement
     // const float FUSE_DURATION = 1.5f; // Member initializers can only be used for non-static data members
                                       // If this is meant to be a constant for all CherryBombs, make it static const or use a #define
                                       // For now, removing it here, assume it's extern or defined in .cpp
     bool exploded;
-    Sound explosionSound; // CherryBomb has its own explosion sound
 
 public:
-    CherryBomb(Rectangle rect, int row, int col, Texture2D tex, Sound expSound);
-    void Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies, std::vector<std::unique_ptr<Projectile>>& projectiles, int& sunCurrency, Sound shootSound, Texture2D peaTex) override;
-    void Draw() const override; // Mark as const to match base
-    int GetCost() const override { return 50; } // Cost for Cherry Bomb
+    CherryBomb(Rectangle rect, int row, int col);
+    void Start(TimerWheel& timers) override;
+    void OnTimer(TimerKind kind, SimContext& ctx) override;
+    void CancelTimers(TimerWheel& timers) override;
     PlantType GetType() const override { return PlantType::CHERRY_BOMB; }
 };
 
 // WallNut
 class WallNut : public Plant {
 public:
-    WallNut(Rectangle rect, int row, int col, Texture2D tex);
-    void Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies, std::vector<std::unique_ptr<Projectile>>& projectiles, int& sunCurrency, Sound shootSound, Texture2D peaTex) override;
-    void Draw() const override; // Mark as const to match base
-    int GetCost() const override { return 75; } // Cost for Wall-nut
+    WallNut(Rectangle rect, int row, int col); // No timers at all, it just takes bites
     PlantType GetType() const override { return PlantType::WALNUT; }
 };
 
@@ -138,22 +153,14 @@ public:
 // Repeater
 class Repeater : public Peashooter { // Repeater can inherit from Peashooter as it's similar
 public:
-    Repeater(Rectangle rect, int row, int col, Texture2D tex);
-    void Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies, std::vector<std::unique_ptr<Projectile>>& projectiles, int& sunCurrency, Sound shootSound, Texture2D peaTex) override;
-    void Draw() const override; // <-- ADDED: Matches implementation in plant.cpp
-    int GetCost() const override { return 200; }
+    Repeater(Rectangle rect, int row, int col); // Two peas per shot, from the table
     PlantType GetType() const override { return PlantType::REPEATER; }
 };
 
 // IcePea
 class IcePea : public Peashooter { // IcePea can also inherit from Peashooter
-private:
-    Texture2D icePeaProjectileTex; // Specific texture for the ice pea projectile
 public:
-    IcePea(Rectangle rect, int row, int col, Texture2D tex, Texture2D icePeaProjTex); // Constructor takes projectile texture
-    void Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies, std::vector<std::unique_ptr<Projectile>>& projectiles, int& sunCurrency, Sound shootSound, Texture2D peaTex) override;
-    void Draw() const override; // <-- ADDED: Matches implementation in plant.cpp
-    int GetCost() const override { return 150; }
+    IcePea(Rectangle rect, int row, int col); // FROZEN peas, drawn with their own texture by ProjectileLanes
     PlantType GetType() const override { return PlantType::ICE_PEA; }
 };
 
@@ -0,0 +1,121 @@
+// projectile.cpp
+#include "projectile.h"
+#include "zombie.h"     // Needed to apply hits to zombies
+#include "lane_index.h" // Zombies sorted per lane
+#include "archetypes.h" // On-hit status effect per projectile type
+#include "sim_context.h"
+#include "sim_events.h"
+#include "status_effects.h"
+#include "render_snapshot.h"
+#include "animation.h"  // Baked projectile frames
+#include <utility>      // For std::swap
+
+//----------------------------------------------------------------------------------
+// Projectile Lanes Implementation
+//----------------------------------------------------------------------------------
+ProjectileLanes::ProjectileLanes(int numLanes)
+    : lanes(numLanes)
+{
+}
+
+void ProjectileLanes::Spawn(int lane, const Projectile& projectile) {
+    if (lane < 0 || lane >= (int)lanes.size()) return;
+
+    RingBuffer<Projectile>& ring = lanes[lane];
+    ring.push_back(projectile);
+
+    // Keep the lane sorted rightmost-first. A plant fires from its own column, so the new
+    // projectile only has to pass the ones still travelling behind it.
+    for (size_t i = ring.size() - 1; i > 0 && ring[i - 1].rect.x < ring[i].rect.x; --i) {
+        std::swap(ring[i - 1], ring[i]);
+    }
+}
+
+void ProjectileLanes::Update(float deltaTime, float rightBound, SimContext& ctx, std::vector<ProjectileHit>& hits) {
+    const LaneIndex& laneIndex = ctx.laneIndex;
+    static const std::vector<Zombie*> noZombies;
+
+    for (int lane = 0; lane < (int)lanes.size(); ++lane) {
+        RingBuffer<Projectile>& ring = lanes[lane];
+
+        // Everyone moves at the same speed, so moving never changes the order
+        for (size_t i = 0; i < ring.size(); ++i) {
+            ring[i].rect.x += ring[i].speed.x * deltaTime;
+        }
+
+        // The rightmost projectiles sit at the head, the off-screen ones are always a prefix
+        while (!ring.empty() && ring.front().rect.x > rightBound) {
+            ring.pop_front();
+        }
+
+        if (ring.empty()) continue;
+
+        const std::vector<Zombie*>& zombies = lane < laneIndex.GetLaneCount() ? laneIndex.GetLane(lane) : noZombies;
+        float maxWidth = lane < laneIndex.GetLaneCount() ? laneIndex.GetMaxWidth(lane) : 0.0f;
+
+        // Merge right to left: projectiles from the head, zombies from the end of the sorted lane
+        int nextZombie = (int)zombies.size() - 1;
+        size_t kept = 0;
+        for (size_t i = 0; i < ring.size(); ++i) {
+            Projectile& projectile = ring[i];
+            float projectileRight = projectile.rect.x + projectile.rect.width;
+
+            // Zombies starting past this projectile are out of reach for it and for every projectile behind it
+            while (nextZombie >= 0 && zombies[nextZombie]->rect.x >= projectileRight) --nextZombie;
+
+            // The projectile hits the nearest (leftmost) active zombie it overlaps
+            Zombie* target = nullptr;
+            for (int z = nextZombie; z >= 0 && zombies[z]->rect.x > projectile.rect.x - maxWidth; --z) {
+                Zombie* zombie = zombies[z];
+                if (zombie->active && zombie->rect.x + zombie->rect.width > projectile.rect.x) {
+                    target = zombie;
+                }
+            }
+
+            if (target) {
+                // Apply projectile effects based on type (ice peas slow)
+                StatusEffectType effect = GetProjectileArchetype(projectile.type).effect;
+                if (effect != StatusEffectType::COUNT) {
+                    ctx.statusEffects.Apply(target, effect);
+                }
+                target->health -= projectile.damage;
+
+                bool killed = target->health <= 0;
+                if (killed) {
+                    target->active = false; // Later projectiles in this pass skip it
+                }
+                hits.push_back({ target, killed });
+                ctx.events.PlaySoundCue(SoundCue::HIT);
+                continue; // Projectile is spent, it is not kept
+            }
+
+            if (kept != i) ring[kept] = projectile;
+            ++kept;
+        }
+        ring.truncate(kept);
+    }
+}
+
+void ProjectileLanes::AppendSprites(const AnimationTable& animations, float clock, std::vector<SpriteInstance>& out) const {
+    Rectangle frame = animations.GetFrame(AnimClipId::PEA, clock);
+    for (int row = 0; row < (int)lanes.size(); ++row) {
+        const RingBuffer<Projectile>& ring = lanes[row];
+        for (size_t i = 0; i < ring.size(); ++i) {
+            const Projectile& projectile = ring[i];
+            if (!projectile.active) continue;
+            // Drawn at the frame's own size, like DrawTextureRec
+            out.push_back({ SpriteLayer::PROJECTILES, row, GetProjectileArchetype(projectile.type).sprite, frame,
+                            { projectile.rect.x, projectile.rect.y, frame.width, frame.height } });
+        }
+    }
+}
+
+void ProjectileLanes::Clear() {
+    for (auto& ring : lanes) ring.clear();
+}
+
+size_t ProjectileLanes::Count() const {
+    size_t total = 0;
+    for (const auto& ring : lanes) total += ring.size();
+    return total;
+}
@@ -3,11 +3,14 @@
 #define PROJECTILE_H
 
 #include "raylib.h" // Needed for Rectangle, Vector2, Color, Texture2D
-#include <vector>   // Needed for Projectile::Update interaction with zombies
-#include <memory>   // Needed for std::unique_ptr
+#include <vector>   // Needed for the per-lane projectile storage
+#include "ring_buffer.h"
 
-// Forward declaration for Zombie, as Projectile might interact with it
+// Forward declarations, projectiles resolve hits against the lane index
 class Zombie;
+struct SimContext;
+struct SpriteInstance;
+class AnimationTable;
 
 // Define ProjectileType ENUM CLASS FIRST
 // This directly fixes the "ProjectileType has not been declared" error.
@@ -25,24 +28,17 @@ public:
     Rectangle rect;
     Vector2 speed;
     bool active;
-    Color color; // Will be replaced by Texture2D for actual pea image
-    Texture2D texture;
-    Rectangle sourceRect;
-    int currentFrame;
-    float frameTimer;
-    float frameSpeed;
-    int numFrames;
+    Color color; // Fallback color, the texture is chosen per type when drawing
     int damage; // Added: Damage value for the projectile
     ProjectileType type; // Added: Type of projectile (normal, frozen, etc.)
 
     // Updated Constructor:
     // This constructor matches the arguments you are passing from plant.cpp.
-    Projectile(Rectangle pRect, Vector2 pSpeed, int pDamage, Texture2D pTex, ProjectileType pType = ProjectileType::NORMAL)
-        : rect(pRect), speed(pSpeed), active(true), damage(pDamage), texture(pTex), type(pType),
-          currentFrame(0), frameTimer(0.0f), frameSpeed(0.1f), numFrames(1) // Default animation values
+    // No texture: projectiles are simulation data, the sprite comes from the archetype by type
+    Projectile(Rectangle pRect, Vector2 pSpeed, int pDamage, ProjectileType pType = ProjectileType::NORMAL)
+        : rect(pRect), speed(pSpeed), active(true),
+          damage(pDamage), type(pType)
     {
-        // Assuming a single-frame texture or a horizontally laid out sprite sheet
-        sourceRect = {0, 0, (float)texture.width / numFrames, (float)texture.height};
         // Set color based on type for debugging/fallback if texture not loaded
         if (type == ProjectileType::FROZEN) {
             color = BLUE;
@@ -51,10 +47,44 @@ public:
         }
     }
 
-    // You will need to implement this in projectile.cpp
-    // The Update method needs access to Zombies to check for collisions and apply effects.
-    void Update(float deltaTime, std::vector<std::unique_ptr<Zombie>>& zombies);
-    void Draw() const;
+    // Empty projectile, only used to fill unused ring buffer slots
+    Projectile() : Projectile((Rectangle){ 0, 0, 0, 0 }, (Vector2){ 0, 0 }, 0) {}
+};
+
+//----------------------------------------------------------------------------------
+// Projectile Lanes
+// Every projectile travels right along its lane at the same speed, so once a
+// projectile is in place its order within the lane never changes. Each lane is
+// a ring buffer kept sorted by x, rightmost at the head:
+//  - the projectiles leaving the screen are always a prefix, removed by pop_front
+//  - hits are resolved by a single merge against the lane index (sorted zombies)
+//  - spent projectiles are dropped by compacting in place, no erase
+//----------------------------------------------------------------------------------
+struct ProjectileHit {
+    Zombie* zombie;
+    bool killed; // True if this hit took the zombie's health to zero
+};
+
+class ProjectileLanes {
+public:
+    explicit ProjectileLanes(int numLanes);
+
+    // New projectiles are usually the leftmost in their lane (appended at the tail),
+    // plants further right only bubble past the few projectiles still behind them
+    void Spawn(int lane, const Projectile& projectile);
+
+    // Moves all projectiles, retires the ones past rightBound and applies hits
+    // (damage and slow) to the zombies in ctx.laneIndex. Hits are appended to 'hits'.
+    void Update(float deltaTime, float rightBound, SimContext& ctx, std::vector<ProjectileHit>& hits);
+
+    // Copies every projectile out for a render snapshot. All projectiles play the
+    // PEA clip in step, straight from the simulation clock.
+    void AppendSprites(const AnimationTable& animations, float clock, std::vector<SpriteInstance>& out) const;
+    void Clear();
+    size_t Count() const;
+
+private:
+    std::vector<RingBuffer<Projectile>> lanes;
 };
 
 #endif // PROJECTILE_H
\ No newline at end of file
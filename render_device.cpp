@@ -0,0 +1,163 @@
+// render_device.cpp
+#include "render_device.h"
+#include "logger.h"
+#include "soft_font.h"
+#include <algorithm> // For std::max, std::min
+#include <memory>    // For std::unique_ptr
+#include <cstring>   // For strlen, strcmp
+#include <cmath>     // For fabsf
+#include <utility>   // For std::swap
+
+namespace {
+    const int MIN_FONT_SIZE = 10; // DrawText never goes below the default font's size
+
+    RenderDeviceType deviceType = RenderDeviceType::RAYLIB;
+    std::unique_ptr<SoftRasterizer> soft;
+    Font softFont = {};
+}
+
+void RenderDeviceInit(RenderDeviceType type, int width, int height) {
+    deviceType = type;
+    if (type != RenderDeviceType::SOFTWARE) return;
+
+    soft.reset(new SoftRasterizer(width, height));
+    Image fontAtlas;
+    softFont = LoadSoftFont(fontAtlas);
+    softFont.texture = RenderLoadTextureFromImage(fontAtlas);
+    UnloadImage(fontAtlas);
+    GAME_LOG_INFO(LogCategory::ASSETS, "Software renderer: %dx%d, %d px tiles", width, height, SOFT_TILE_SIZE);
+}
+
+void RenderDeviceShutdown() {
+    if (deviceType != RenderDeviceType::SOFTWARE) return;
+    UnloadSoftFont(softFont);
+    soft.reset();
+}
+
+bool RenderIsSoftware() {
+    return deviceType == RenderDeviceType::SOFTWARE;
+}
+
+SoftRasterizer* RenderGetSoftRasterizer() {
+    return soft.get();
+}
+
+Texture2D RenderLoadTexture(const char* fileName) {
+    if (!RenderIsSoftware()) return LoadTexture(fileName);
+    Image image = LoadImage(fileName);
+    Texture2D texture = RenderLoadTextureFromImage(image);
+    UnloadImage(image);
+    return texture;
+}
+
+Texture2D RenderLoadTextureFromImage(const Image& image) {
+    if (!RenderIsSoftware()) return LoadTextureFromImage(image);
+    Texture2D texture = {};
+    texture.id = soft->AddTexture(image);
+    if (texture.id == 0) return texture;
+    texture.width = image.width;
+    texture.height = image.height;
+    texture.mipmaps = 1;
+    texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return texture;
+}
+
+void RenderUnloadTexture(Texture2D texture) {
+    if (!RenderIsSoftware()) UnloadTexture(texture);
+    else soft->RemoveTexture(texture.id);
+}
+
+Font RenderGetFont() {
+    return RenderIsSoftware() ? softFont : GetFontDefault();
+}
+
+void RenderBeginFrame() {
+    if (!RenderIsSoftware()) BeginDrawing();
+    else soft->Begin();
+}
+
+void RenderEndFrame() {
+    if (!RenderIsSoftware()) EndDrawing();
+    else soft->End();
+}
+
+void RenderClear(Color color) {
+    if (!RenderIsSoftware()) ClearBackground(color);
+    else soft->Clear(color);
+}
+
+void RenderTexturedRect(const Texture2D& texture, Rectangle source, Rectangle dest, Color tint) {
+    if (!RenderIsSoftware()) {
+        DrawTexturePro(texture, source, dest, (Vector2){ 0, 0 }, 0.0f, tint);
+        return;
+    }
+    if (texture.id == 0 || texture.width <= 0 || texture.height <= 0) return;
+
+    // Like DrawTexturePro, a negative size samples the source mirrored
+    float u0 = source.x / texture.width;
+    float v0 = source.y / texture.height;
+    float u1 = (source.x + fabsf(source.width)) / texture.width;
+    float v1 = (source.y + fabsf(source.height)) / texture.height;
+    if (source.width < 0) std::swap(u0, u1);
+    if (source.height < 0) std::swap(v0, v1);
+    soft->DrawQuad(texture.id, u0, v0, u1, v1, dest, tint);
+}
+
+void RenderRect(Rectangle rect, Color color) {
+    if (!RenderIsSoftware()) DrawRectangleRec(rect, color);
+    else soft->DrawQuad(0, 0, 0, 0, 0, rect, color);
+}
+
+void RenderRectLines(Rectangle rect, float thickness, Color color) {
+    if (!RenderIsSoftware()) {
+        DrawRectangleLinesEx(rect, thickness, color);
+        return;
+    }
+    // DrawRectangleLinesEx's four pieces: full-width top and bottom, sides in between
+    thickness = std::min(thickness, std::min(rect.width, rect.height) / 2.0f);
+    RenderRect({ rect.x, rect.y, rect.width, thickness }, color);
+    RenderRect({ rect.x, rect.y + rect.height - thickness, rect.width, thickness }, color);
+    RenderRect({ rect.x, rect.y + thickness, thickness, rect.height - thickness * 2.0f }, color);
+    RenderRect({ rect.x + rect.width - thickness, rect.y + thickness, thickness, rect.height - thickness * 2.0f }, color);
+}
+
+// Mirrors DrawTextEx and DrawTextCodepoint, like TextCache::Layout
+void RenderText(const char* text, int x, int y, int fontSize, Color color) {
+    if (!RenderIsSoftware()) {
+        DrawText(text, x, y, fontSize, color);
+        return;
+    }
+    if (softFont.texture.id == 0) return;
+
+    const Font& font = softFont;
+    fontSize = std::max(fontSize, MIN_FONT_SIZE);
+    float scale = (float)fontSize / font.baseSize;
+    float spacing = (float)(fontSize / MIN_FONT_SIZE);
+    float padding = (float)font.glyphPadding;
+
+    float offsetX = 0.0f;
+    int length = (int)strlen(text);
+    for (int i = 0; i < length;) {
+        int codepointSize = 0;
+        int codepoint = GetCodepointNext(&text[i], &codepointSize);
+        i += codepointSize;
+        int index = GetGlyphIndex(font, codepoint);
+        const Rectangle& rec = font.recs[index];
+        const GlyphInfo& glyph = font.glyphs[index];
+
+        if (codepoint != ' ' && codepoint != '\t') {
+            Rectangle source = { rec.x - padding, rec.y - padding, rec.width + 2.0f * padding, rec.height + 2.0f * padding };
+            Rectangle dest = { x + offsetX + (glyph.offsetX - padding) * scale, y + (glyph.offsetY - padding) * scale,
+                               source.width * scale, source.height * scale };
+            RenderTexturedRect(softFont.texture, source, dest, color);
+        }
+        offsetX += (glyph.advanceX == 0 ? rec.width : (float)glyph.advanceX) * scale + spacing;
+    }
+}
+
+bool RenderSaveFrame(const char* fileName) {
+    if (!RenderIsSoftware()) return false;
+    const char* extension = GetFileExtension(fileName);
+    if (extension != nullptr && strcmp(extension, ".raw") == 0) return soft->ExportRaw(fileName);
+    return soft->ExportPng(fileName);
+}
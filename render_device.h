@@ -0,0 +1,53 @@
+// render_device.h
+#ifndef RENDER_DEVICE_H
+#define RENDER_DEVICE_H
+
+#include "raylib.h"
+#include "soft_raster.h"
+
+//----------------------------------------------------------------------------------
+// Render Device
+// The few drawing primitives the game uses, textures, filled and outlined
+// rects and default-font text, go through here instead of straight to raylib.
+// The device is picked once at startup:
+//  - RAYLIB forwards every call to the raylib window as before.
+//  - SOFTWARE needs no window or GPU. Textures become SoftRasterizer copies,
+//    whose ids stand in the Texture2D ids, and a frame is rasterized on the
+//    CPU at RenderEndFrame, from where it can be saved to disk.
+// Paths that need a GPU either way (the HUD render texture, the horde shader)
+// check RenderIsSoftware and use their existing fallback.
+//----------------------------------------------------------------------------------
+enum class RenderDeviceType {
+    RAYLIB,   // After InitWindow
+    SOFTWARE  // Headless, instead of InitWindow
+};
+
+void RenderDeviceInit(RenderDeviceType type, int width, int height);
+void RenderDeviceShutdown();
+bool RenderIsSoftware();
+// nullptr on the raylib device
+SoftRasterizer* RenderGetSoftRasterizer();
+
+Texture2D RenderLoadTexture(const char* fileName);
+Texture2D RenderLoadTextureFromImage(const Image& image);
+void RenderUnloadTexture(Texture2D texture);
+// The default font: raylib's on the raylib device, a CPU rebuild of it (see
+// soft_font.h) on the software device, whose texture is a SoftRasterizer id
+Font RenderGetFont();
+
+void RenderBeginFrame();
+void RenderEndFrame();
+void RenderClear(Color color);
+// Same as DrawTexturePro without origin and rotation, negative source sizes mirror
+void RenderTexturedRect(const Texture2D& texture, Rectangle source, Rectangle dest, Color tint);
+void RenderRect(Rectangle rect, Color color);
+// Same as DrawRectangleLinesEx, the outline lies inside 'rect'
+void RenderRectLines(Rectangle rect, float thickness, Color color);
+// Same as DrawText
+void RenderText(const char* text, int x, int y, int fontSize, Color color);
+
+// Writes the last finished frame, raw RGBA8 for a ".raw" name and PNG otherwise.
+// Software device only.
+bool RenderSaveFrame(const char* fileName);
+
+#endif // RENDER_DEVICE_H
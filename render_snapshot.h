@@ -0,0 +1,52 @@
+// render_snapshot.h
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include "raylib.h"
+#include <vector>
+#include "texture_atlas.h" // For SpriteId
+#include "sprite_batch.h"  // For SpriteLayer
+
+//----------------------------------------------------------------------------------
+// Render Snapshot
+// Everything the main thread needs to draw one simulation tick, copied out of
+// the entities by the simulation thread. Plain values only: the renderer never
+// follows a pointer into simulation state. Snapshots are reused, so the
+// vectors keep their capacity from tick to tick.
+//----------------------------------------------------------------------------------
+enum class SimStatus {
+    STOPPED,        // Menu or paused, no ticks run
+    RUNNING,
+    LEVEL_COMPLETE, // Target score reached, stopped until the next reset
+    GAME_OVER       // A zombie reached the house, stopped until the next reset
+};
+
+struct SpriteInstance {
+    SpriteLayer layer;
+    int lane;          // Grid row, lower lanes are drawn over the ones above
+    SpriteId sprite;   // Resolved to an atlas page and rect by the main thread
+    Rectangle source;  // Current frame, relative to the sprite
+    Rectangle dest;
+};
+
+// Visibility and level-of-detail counts of one tick
+struct SimLodCounts {
+    int awakeZombies;   // Animated, collision tested and drawn if on screen
+    int dormantZombies; // Off-screen, walking in coarse steps only
+    int drawnSprites;
+    int culledSprites;  // Outside the screen, left out of 'sprites'
+};
+
+struct RenderSnapshot {
+    std::vector<SpriteInstance> sprites; // Any order, the batch sorts by lane and layer
+    int sunCurrency = 0;
+    int score = 0;
+    int level = 1;
+    int targetScore = 0;
+    SimStatus status = SimStatus::STOPPED;
+    SimLodCounts lod = {};
+    int generation = 0;                  // Resets applied so far, tells a stale status from a current one
+    unsigned long long tick = 0;         // Ticks simulated so far
+};
+
+#endif // RENDER_SNAPSHOT_H
@@ -0,0 +1,66 @@
+// ring_buffer.h
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <vector>
+#include <cstddef> // For size_t
+#include <utility> // For std::move
+
+//----------------------------------------------------------------------------------
+// Ring Buffer
+// Growable ring with a power-of-two capacity. Push at the tail, pop at the head,
+// both O(1). Indices count from the head, and elements may be reordered in place,
+// so the order is whatever the owner keeps: ProjectileLanes insertion-sorts each
+// lane rightmost-first, making index 0 the rightmost projectile, not the oldest.
+//----------------------------------------------------------------------------------
+template <typename T>
+class RingBuffer {
+public:
+    RingBuffer() : head(0), count(0) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    T& operator[](size_t i) { return buffer[(head + i) & (buffer.size() - 1)]; }
+    const T& operator[](size_t i) const { return buffer[(head + i) & (buffer.size() - 1)]; }
+
+    T& front() { return (*this)[0]; }
+    T& back() { return (*this)[count - 1]; }
+
+    void push_back(const T& value) {
+        if (count == buffer.size()) Grow();
+        (*this)[count] = value;
+        ++count;
+    }
+
+    void pop_front() {
+        head = (head + 1) & (buffer.size() - 1);
+        --count;
+    }
+
+    // Drops elements from the tail, used after compacting live elements towards the head
+    void truncate(size_t newCount) {
+        if (newCount < count) count = newCount;
+    }
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+private:
+    void Grow() {
+        std::vector<T> grown(buffer.empty() ? 16 : buffer.size() * 2);
+        for (size_t i = 0; i < count; ++i) {
+            grown[i] = std::move((*this)[i]);
+        }
+        buffer.swap(grown);
+        head = 0;
+    }
+
+    std::vector<T> buffer; // Size is always zero or a power of two
+    size_t head;
+    size_t count;
+};
+
+#endif // RING_BUFFER_H
@@ -0,0 +1,28 @@
+// sim_context.h
+#ifndef SIM_CONTEXT_H
+#define SIM_CONTEXT_H
+
+// Forward declarations, the context only refers to the systems
+class TimerWheel;
+class LaneIndex;
+class ProjectileLanes;
+class StatusEffects;
+class SimEvents;
+
+//----------------------------------------------------------------------------------
+// Simulation Context
+// Everything an entity may read or write while it updates, passed by reference
+// instead of a growing list of parameters. Nothing in here is a raylib
+// resource, so the simulation runs the same without a window or audio device.
+//----------------------------------------------------------------------------------
+struct SimContext {
+    TimerWheel& timers;
+    const LaneIndex& laneIndex; // Rebuilt once per tick, after the zombies moved
+    ProjectileLanes& projectiles;
+    StatusEffects& statusEffects;
+    SimEvents& events;          // Output for the presentation side
+    int& sunCurrency;
+    const float& clock;         // Simulation time in seconds, animation phases are taken from it
+};
+
+#endif // SIM_CONTEXT_H
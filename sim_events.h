@@ -0,0 +1,81 @@
+// sim_events.h
+#ifndef SIM_EVENTS_H
+#define SIM_EVENTS_H
+
+#include <vector>
+#include "plant.h"      // For PlantType
+#include "zombie.h"     // For ZombieType
+#include "projectile.h" // For ProjectileType
+
+//----------------------------------------------------------------------------------
+// Simulation Events
+// Simulation code never plays sounds or touches presentation resources. It
+// appends what happened to this buffer instead, and the presentation side
+// (audio, effects, logs) consumes it once the tick is over. Events only hold
+// plain values, never pointers: the entities may be gone by then.
+//----------------------------------------------------------------------------------
+enum class SoundCue {
+    SHOOT,
+    HIT,
+    EXPLOSION,
+    LAWNMOWER,
+    GAME_OVER,
+    DIG,
+    COUNT
+};
+
+enum class SimEventType {
+    PROJECTILE_SPAWNED,
+    SOUND_CUE,
+    ZOMBIE_KILLED,
+    PLANT_DIED
+};
+
+struct SimEvent {
+    SimEventType type;
+    int lane;           // -1 when not tied to a lane (sound cues)
+    float x;            // Where it happened
+    float y;
+    union {
+        SoundCue cue;                  // SOUND_CUE
+        ProjectileType projectileType; // PROJECTILE_SPAWNED
+        ZombieType zombieType;         // ZOMBIE_KILLED
+        PlantType plantType;           // PLANT_DIED
+    };
+};
+
+class SimEvents {
+public:
+    void ProjectileSpawned(int lane, float x, float y, ProjectileType type) {
+        SimEvent event = { SimEventType::PROJECTILE_SPAWNED, lane, x, y, {} };
+        event.projectileType = type;
+        events.push_back(event);
+    }
+
+    void PlaySoundCue(SoundCue cue) {
+        SimEvent event = { SimEventType::SOUND_CUE, -1, 0.0f, 0.0f, {} };
+        event.cue = cue;
+        events.push_back(event);
+    }
+
+    void ZombieKilled(int lane, float x, float y, ZombieType type) {
+        SimEvent event = { SimEventType::ZOMBIE_KILLED, lane, x, y, {} };
+        event.zombieType = type;
+        events.push_back(event);
+    }
+
+    void PlantDied(int lane, float x, float y, PlantType type) {
+        SimEvent event = { SimEventType::PLANT_DIED, lane, x, y, {} };
+        event.plantType = type;
+        events.push_back(event);
+    }
+
+    const std::vector<SimEvent>& GetEvents() const { return events; }
+    // Called by the consumer once everything has been handled, keeps the capacity
+    void Clear() { events.clear(); }
+
+private:
+    std::vector<SimEvent> events; // Append-only during a tick
+};
+
+#endif // SIM_EVENTS_H
@@ -0,0 +1,106 @@
+// sim_thread.cpp
+#include "sim_thread.h"
+#include "game_constants.h"
+#include "logger.h"
+#include <chrono>
+
+//----------------------------------------------------------------------------------
+// Simulation Thread Implementation
+//----------------------------------------------------------------------------------
+SimThread::SimThread(Simulation& simulation)
+    : simulation(simulation), running(false), droppedEvents(0)
+{
+}
+
+SimThread::~SimThread() {
+    Stop();
+}
+
+void SimThread::Start() {
+    if (running.exchange(true)) return;
+    thread = std::thread(&SimThread::Run, this);
+}
+
+void SimThread::Stop() {
+    if (!running.exchange(false)) return;
+    thread.join();
+}
+
+void SimThread::PushCommand(const SimCommand& command) {
+    if (backlog.empty() && commands.Push(command)) return;
+    if (backlog.empty()) GAME_LOG_WARNING(LogCategory::GAMEPLAY, "Simulation command queue full, holding commands for the next frame");
+    backlog.push_back(command); // Behind any older ones, the order is kept
+}
+
+void SimThread::FlushCommands() {
+    size_t queued = 0;
+    while (queued < backlog.size() && commands.Push(backlog[queued])) ++queued;
+    backlog.erase(backlog.begin(), backlog.begin() + queued);
+}
+
+bool SimThread::PopEvent(SimEvent& event) {
+    return events.Pop(event);
+}
+
+const RenderSnapshot& SimThread::AcquireSnapshot() {
+    snapshots.Acquire(); // Keeps the previous snapshot if nothing new was published
+    return snapshots.GetReadBuffer();
+}
+
+void SimThread::Step(int ticks) {
+    FlushCommands();
+    ApplyCommands();
+    for (int i = 0; i < ticks && simulation.IsRunning(); ++i) {
+        simulation.Tick(SIM_TICK_INTERVAL);
+    }
+    PublishSnapshot();
+}
+
+void SimThread::ApplyCommands() {
+    SimCommand command;
+    while (commands.Pop(command)) simulation.Apply(command);
+}
+
+void SimThread::ForwardEvents() {
+    SimEvents& simEvents = simulation.GetEvents();
+    for (const SimEvent& event : simEvents.GetEvents()) {
+        if (!events.Push(event)) droppedEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+    simEvents.Clear();
+}
+
+void SimThread::PublishSnapshot() {
+    ForwardEvents();
+    simulation.WriteSnapshot(snapshots.GetWriteBuffer());
+    snapshots.Publish();
+}
+
+void SimThread::Run() {
+    typedef std::chrono::steady_clock Clock;
+    const Clock::duration tickInterval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(SIM_TICK_INTERVAL));
+    Clock::time_point nextTick = Clock::now();
+
+    while (running.load(std::memory_order_acquire)) {
+        ApplyCommands();
+
+        Clock::time_point now = Clock::now();
+        if (simulation.IsRunning()) {
+            // Fixed steps for the real time that passed, but never more than a few at once:
+            // after a stall the game slows down instead of trying to catch up forever
+            int steps = 0;
+            while (nextTick <= now && steps < SIM_MAX_STEPS_PER_WAKE && simulation.IsRunning()) {
+                simulation.Tick(SIM_TICK_INTERVAL);
+                nextTick += tickInterval;
+                ++steps;
+            }
+            if (nextTick <= now) nextTick = now + tickInterval;
+        } else {
+            nextTick = now + tickInterval; // Stopped: only poll for commands
+        }
+
+        PublishSnapshot();
+
+        std::this_thread::sleep_until(nextTick);
+    }
+}
@@ -0,0 +1,68 @@
+// sim_thread.h
+#ifndef SIM_THREAD_H
+#define SIM_THREAD_H
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include "simulation.h"
+#include "spsc_queue.h"
+#include "triple_buffer.h"
+#include "render_snapshot.h"
+#include "sim_events.h"
+
+//----------------------------------------------------------------------------------
+// Simulation Thread
+// Runs the Simulation at its own fixed tick rate (SIM_TICK_INTERVAL), decoupled
+// from the render frame rate. Three channels connect it to the main thread:
+//  - commands (input) flow in through a lock-free SPSC queue
+//  - a RenderSnapshot is published after every step into a triple buffer, the
+//    main thread always draws the latest one
+//  - events (sound cues) flow out through a second SPSC queue, so none are lost
+//    when the renderer skips snapshots
+// Between Start and Stop the Simulation belongs to this thread alone.
+//
+// Headless runs never Start it. They call Step once per frame instead, which
+// does the same work for a fixed number of ticks on the calling thread, so a
+// given frame always shows the same simulation state.
+//----------------------------------------------------------------------------------
+class SimThread {
+public:
+    explicit SimThread(Simulation& simulation);
+    ~SimThread();
+
+    void Start();
+    void Stop();
+    // Instead of Start: applies the queued commands, runs 'ticks' steps while the
+    // game is running and publishes a snapshot, all before returning
+    void Step(int ticks);
+
+    // Main thread side. A command that does not fit in the queue waits in a backlog
+    // and is retried in order by FlushCommands, so none is lost.
+    void PushCommand(const SimCommand& command);
+    // Once per frame: moves backlogged commands into the queue as it frees up
+    void FlushCommands();
+    bool PopEvent(SimEvent& event);
+    // Latest published snapshot, stays valid until the next call
+    const RenderSnapshot& AcquireSnapshot();
+
+    unsigned long long GetDroppedEventCount() const { return droppedEvents.load(std::memory_order_relaxed); }
+
+private:
+    void Run();
+    void ApplyCommands();
+    void ForwardEvents();
+    void PublishSnapshot();
+
+    Simulation& simulation;
+    std::thread thread;
+    std::atomic<bool> running;
+    std::atomic<unsigned long long> droppedEvents;
+
+    SpscQueue<SimCommand, 64> commands;
+    std::vector<SimCommand> backlog;   // Main thread only, waiting for room in 'commands'
+    SpscQueue<SimEvent, 1024> events;
+    TripleBuffer<RenderSnapshot> snapshots;
+};
+
+#endif // SIM_THREAD_H
@@ -0,0 +1,429 @@
+// simulation.cpp
+#include "simulation.h"
+#include "game_constants.h"
+#include "archetypes.h" // Costs and placement rules
+#include <algorithm>    // For std::remove_if
+
+int CalculateTargetScore(int level) {
+    return level == 1 ? 1000 : 1000 + (level - 1) * 3000;
+}
+
+//----------------------------------------------------------------------------------
+// Simulation Implementation
+//----------------------------------------------------------------------------------
+Simulation::Simulation(const SimTextures& textures)
+    : textures(textures),
+      projectiles(GRID_ROWS),
+      laneIndex(GRID_ROWS),
+      broadphase(),
+      contactScheduler(broadphase),
+      timerWheel(TIMER_WHEEL_TICK),
+      sunCurrency(50),
+      clock(0.0f),
+      context{ timerWheel, laneIndex, projectiles, statusEffects, simEvents, sunCurrency, clock },
+      score(0),
+      level(1),
+      targetScore(CalculateTargetScore(1)),
+      zombieSpawnTimer(0.0f),
+      zombieSpawnRate(5.0f),
+      status(SimStatus::STOPPED),
+      generation(0),
+      tickCount(0),
+      zombieMoves(0),
+      lodStats{ 0, 0, 0, 0 }
+{
+    broadphase.SetBoundsFunction(BroadphaseKind::PLANT, Plant::BoundsOf);
+    broadphase.SetBoundsFunction(BroadphaseKind::ZOMBIE, Zombie::BoundsOf);
+    broadphase.SetBoundsFunction(BroadphaseKind::MOWER, LawnMower::BoundsOf);
+
+    // Every clip's frame rects, cut once from the sprite sizes
+    Vector2 spriteSizes[(int)SpriteId::COUNT] = {};
+    for (int type = 0; type < (int)PlantType::NONE; ++type) {
+        const PlantArchetype& archetype = GetPlantArchetype((PlantType)type);
+        if (archetype.sprite != SpriteId::COUNT) {
+            spriteSizes[(int)archetype.sprite] = { (float)textures.plants[type].width, (float)textures.plants[type].height };
+        }
+    }
+    spriteSizes[(int)GetZombieArchetype(ZombieType::REGULAR).sprite] = { (float)textures.regularZombie.width, (float)textures.regularZombie.height };
+    spriteSizes[(int)GetZombieArchetype(ZombieType::JUMPING).sprite] = { (float)textures.jumpingZombie.width, (float)textures.jumpingZombie.height };
+    for (int type = 0; type <= (int)ProjectileType::FROZEN; ++type) {
+        const Texture2D& texture = textures.projectiles[type];
+        spriteSizes[(int)GetProjectileArchetype((ProjectileType)type).sprite] = { (float)texture.width, (float)texture.height };
+    }
+    animations.Bake(spriteSizes);
+}
+
+void Simulation::Apply(const SimCommand& command) {
+    switch (command.type) {
+        case SimCommandType::RESET_LEVEL:
+            Reset(command.value);
+            break;
+        case SimCommandType::SET_RUNNING:
+            // A finished level stays finished until the next reset
+            if (status == SimStatus::STOPPED || status == SimStatus::RUNNING) {
+                status = command.value ? SimStatus::RUNNING : SimStatus::STOPPED;
+            }
+            break;
+        case SimCommandType::PLACE_PLANT:
+            if (status == SimStatus::RUNNING) PlacePlant(command.row, command.col, command.plantType);
+            break;
+        case SimCommandType::DIG_PLANT:
+            if (status == SimStatus::RUNNING) DigPlant(command.row, command.col);
+            break;
+    }
+}
+
+void Simulation::Reset(int levelToSet) {
+    statusEffects.Clear(); // Resets the zombies' rows, so before they are destroyed
+    plants.clear();
+    zombies.clear();
+    projectiles.Clear();
+    lawnmowers.clear();
+    laneIndex.Clear();
+    contactScheduler.Reset();
+    broadphase.Clear();
+    timerWheel.Clear(); // Every owner is gone, drop their deadlines with them
+
+    for (int i = 0; i < GRID_ROWS; ++i) {
+        Rectangle mowerRect = {
+            (float)GRID_START_X - TILE_SIZE,
+            (float)GRID_START_Y + i * TILE_SIZE,
+            TILE_SIZE / 2.0f * 1.8f,
+            TILE_SIZE / 2.0f * 1.8f
+        };
+        lawnmowers.push_back(std::make_unique<LawnMower>(mowerRect, i, textures.lawnmower));
+        lawnmowers.back()->broadphaseId = broadphase.Add(BroadphaseKind::MOWER, lawnmowers.back().get());
+    }
+
+    zombieSpawnTimer = 0.0f;
+    clock = 0.0f;
+    sunCurrency = 50;
+    score = 0;
+    level = levelToSet;
+    targetScore = CalculateTargetScore(level);
+    status = SimStatus::STOPPED;
+    ++generation;
+
+    zombieSpawnRate = 5.0f - (level - 1) * 0.4f;
+    if (zombieSpawnRate < 1.0f) zombieSpawnRate = 1.0f;
+
+    int initialZombies = level * 2;
+    if (initialZombies > 10) initialZombies = 10;
+
+    for (int i = 0; i < initialZombies; ++i) {
+        SpawnZombie((float)SCREEN_WIDTH + i * TILE_SIZE, GetRandomValue(0, GRID_ROWS - 1));
+    }
+}
+
+void Simulation::SpawnZombie(float x, int spawnRow) {
+    Rectangle zombieRect = {
+        x,
+        (float)GRID_START_Y + spawnRow * TILE_SIZE + (TILE_SIZE / 4.0f),
+        TILE_SIZE / 2.0f * 2.8f,
+        TILE_SIZE / 2.0f * 2.8f
+    };
+
+    // Fix for the unique_ptr type mismatch error
+    std::unique_ptr<Zombie> newZombie;
+    if (GetRandomValue(0, 1) == 0) {
+        newZombie = std::make_unique<RegularZombie>(zombieRect, spawnRow, level);
+    } else {
+        newZombie = std::make_unique<JumpingZombie>(zombieRect, spawnRow, level);
+    }
+
+    // Spawned well right of the screen: only walk until about to come into view
+    if (x - newZombie->speed * SIM_LOD_COARSE_INTERVAL >= SCREEN_WIDTH) {
+        newZombie->dormant = true;
+        newZombie->walkedMoves = zombieMoves;
+        newZombie->coarseStepTimer = timerWheel.Schedule(SIM_LOD_COARSE_INTERVAL, TimerKind::ZOMBIE_COARSE_STEP, newZombie.get());
+    } else {
+        newZombie->broadphaseId = broadphase.Add(BroadphaseKind::ZOMBIE, newZombie.get());
+    }
+    newZombie->animPhase = clock; // Dormant or not, so waking up does not restart the walk cycle
+    zombies.push_back(std::move(newZombie));
+}
+
+// The walking of every move pass it skipped, one pass at a time like Zombie::Update,
+// so the position comes out exactly as if the zombie had never been dormant
+void Simulation::CatchUpDormantZombie(Zombie* zombie) {
+    for (; zombie->walkedMoves < zombieMoves; ++zombie->walkedMoves) {
+        zombie->rect.x -= zombie->speed * SIM_TICK_INTERVAL;
+    }
+}
+
+// Peas leave the screen and the lawn ends before its right edge, so only a
+// running mower sweeps past it, and WakeRow brings those zombies back first.
+// Nothing else reaches them: the walking can be caught up once per coarse step.
+// Status effects never apply there, 'speed' is still the base speed.
+void Simulation::StepDormantZombie(Zombie* zombie) {
+    CatchUpDormantZombie(zombie);
+    lodStats.coarseSteps++;
+    if (zombie->rect.x - zombie->speed * SIM_LOD_COARSE_INTERVAL < SCREEN_WIDTH) {
+        WakeZombie(zombie);
+    } else {
+        zombie->coarseStepTimer = timerWheel.Schedule(SIM_LOD_COARSE_INTERVAL, TimerKind::ZOMBIE_COARSE_STEP, zombie);
+    }
+}
+
+void Simulation::WakeZombie(Zombie* zombie) {
+    zombie->dormant = false;
+    zombie->broadphaseId = broadphase.Add(BroadphaseKind::ZOMBIE, zombie); // contactCheckPending is still set from the spawn
+    lodStats.wakeUps++;
+}
+
+// A mower about to sweep 'row' past the screen edge: its dormant zombies wake
+// where they would be without LOD, so the sweep kills the same zombies
+void Simulation::WakeRow(int row) {
+    for (const auto& zombie : zombies) {
+        if (!zombie->dormant || zombie->row != row) continue;
+        timerWheel.Cancel(zombie->coarseStepTimer);
+        CatchUpDormantZombie(zombie.get());
+        WakeZombie(zombie.get());
+    }
+}
+
+void Simulation::PlacePlant(int row, int col, PlantType type) {
+    if (row < 0 || row >= GRID_ROWS || col < 0 || col >= GRID_COLS) return;
+
+    for (const auto& plant : plants) {
+        if (plant->row == row && plant->col == col) return; // Tile already taken
+    }
+
+    std::unique_ptr<Plant> newPlant = nullptr;
+    Rectangle plantRect = {
+        (float)GRID_START_X + col * TILE_SIZE + (TILE_SIZE / 4.0f),
+        (float)GRID_START_Y + row * TILE_SIZE + (TILE_SIZE / 4.0f),
+        TILE_SIZE / 2.0f * 1.8f,
+        TILE_SIZE / 2.0f * 1.8f
+    };
+
+    // One table lookup covers the cost of every plant type
+    const PlantArchetype& archetype = GetPlantArchetype(type);
+    if (!archetype.placeable || sunCurrency < archetype.cost) return;
+
+    switch (type) {
+        case PlantType::PEASHOOTER:
+            newPlant = std::make_unique<Peashooter>(plantRect, row, col);
+            break;
+        case PlantType::SUNFLOWER:
+            newPlant = std::make_unique<Sunflower>(plantRect, row, col);
+            break;
+        case PlantType::CHERRY_BOMB:
+            newPlant = std::make_unique<CherryBomb>(plantRect, row, col);
+            break;
+        case PlantType::WALNUT:
+            newPlant = std::make_unique<WallNut>(plantRect, row, col);
+            break;
+        case PlantType::REPEATER:
+            newPlant = std::make_unique<Repeater>(plantRect, row, col);
+            break;
+        case PlantType::ICE_PEA:
+            newPlant = std::make_unique<IcePea>(plantRect, row, col);
+            break;
+        default:
+            break;
+    }
+
+    if (newPlant) {
+        sunCurrency -= archetype.cost;
+        newPlant->broadphaseId = broadphase.Add(BroadphaseKind::PLANT, newPlant.get());
+        contactScheduler.OnPlantAdded(newPlant.get());
+        newPlant->animPhase = clock;
+        newPlant->Start(timerWheel);
+        plants.push_back(std::move(newPlant));
+    }
+}
+
+void Simulation::DigPlant(int row, int col) {
+    for (int i = plants.size() - 1; i >= 0; --i) {
+        if (plants[i]->row == row && plants[i]->col == col) {
+            broadphase.Remove(BroadphaseKind::PLANT, plants[i]->broadphaseId);
+            plants[i]->CancelTimers(timerWheel);
+            plants.erase(plants.begin() + i);
+            simEvents.PlaySoundCue(SoundCue::DIG);
+            break;
+        }
+    }
+}
+
+void Simulation::Tick(float deltaTime) {
+    if (status != SimStatus::RUNNING) return;
+    ++tickCount;
+    clock += deltaTime;
+
+    // Level completion check
+    if (score >= targetScore) {
+        status = SimStatus::LEVEL_COMPLETE;
+        return;
+    }
+
+    // Zombie spawning
+    zombieSpawnTimer += deltaTime;
+    if (zombieSpawnTimer >= zombieSpawnRate) {
+        zombieSpawnTimer = 0.0f;
+        SpawnZombie((float)SCREEN_WIDTH, GetRandomValue(0, GRID_ROWS - 1));
+    }
+
+    // Expired timers: plants fire, produce sun and explode, zombies bite. Nothing
+    // is visited when none of its deadlines is due.
+    firedTimers.clear();
+    timerWheel.Advance(deltaTime, firedTimers);
+    for (const FiredTimer& timer : firedTimers) {
+        switch (timer.kind) {
+            case TimerKind::ZOMBIE_BITE:
+                static_cast<Zombie*>(timer.owner)->OnTimer(timer.kind, context);
+                break;
+            case TimerKind::ZOMBIE_COARSE_STEP:
+                StepDormantZombie(static_cast<Zombie*>(timer.owner));
+                break;
+            default:
+                static_cast<Plant*>(timer.owner)->OnTimer(timer.kind, context);
+                break;
+        }
+    }
+
+    // Placements, spawns and last tick's movement are in, restore the broadphase order
+    broadphase.Update();
+
+    // Zombies that crossed a waiting mower's trigger line set it off
+    broadphasePairs.clear();
+    broadphase.CollectPairs(BroadphaseKind::MOWER, BroadphaseKind::ZOMBIE, broadphasePairs);
+    for (const BroadphasePair& pair : broadphasePairs) {
+        LawnMower* mower = static_cast<LawnMower*>(pair.a);
+        if (!mower->activated && static_cast<Zombie*>(pair.b)->active) {
+            mower->activated = true;
+            broadphase.Remove(BroadphaseKind::MOWER, mower->broadphaseId); // Only waiting mowers are tracked
+            mower->broadphaseId = -1;
+            WakeRow(mower->row);
+            simEvents.PlaySoundCue(SoundCue::LAWNMOWER);
+        }
+    }
+
+    // Update zombies. Only zombies woken by the scheduler look for a plant,
+    // walking zombies just integrate their movement.
+    statusEffects.Update(deltaTime); // Expiry and burn damage, before the kill checks below
+    contactScheduler.Advance(deltaTime);
+    ++zombieMoves;
+    for (int i = zombies.size() - 1; i >= 0; --i) {
+        if (zombies[i]->dormant) { // Walks on its coarse step timer, nothing else to do
+            lodStats.dormantSkips++;
+            continue;
+        }
+        lodStats.zombieUpdates++;
+        Plant* contactPlant = contactScheduler.Resolve(zombies[i].get());
+        zombies[i]->Update(deltaTime, contactPlant, context);
+
+        if (zombies[i]->health <= 0 && zombies[i]->active) {
+            score += zombies[i]->scoreValue;
+            zombies[i]->active = false;
+        }
+
+        if (!zombies[i]->active) {
+            simEvents.ZombieKilled(zombies[i]->row, zombies[i]->rect.x, zombies[i]->rect.y, zombies[i]->GetType());
+            contactScheduler.Forget(zombies[i].get());
+            zombies[i]->CancelTimers(timerWheel);
+            statusEffects.Remove(zombies[i].get());
+            broadphase.Remove(BroadphaseKind::ZOMBIE, zombies[i]->broadphaseId);
+            zombies.erase(zombies.begin() + i);
+            continue;
+        }
+
+        if (zombies[i]->rect.x < GRID_START_X - TILE_SIZE) {
+            status = SimStatus::GAME_OVER;
+            simEvents.PlaySoundCue(SoundCue::GAME_OVER);
+            return;
+        }
+    }
+
+    // Zombies have moved, refresh the per-lane lookup used by the queries below
+    laneIndex.Rebuild(zombies);
+
+    // Update projectiles (per-lane rings, hits resolved against the lane index)
+    projectileHits.clear();
+    projectiles.Update(deltaTime, (float)SCREEN_WIDTH, context, projectileHits);
+    for (const ProjectileHit& hit : projectileHits) {
+        if (hit.killed) { // Only add score if zombie is actually defeated by this projectile
+            score += hit.zombie->scoreValue;
+        }
+    }
+
+    // Update lawnmowers
+    for (auto& mower : lawnmowers) {
+        if (mower->activated && mower->active) {
+            // Sweep the whole interval covered during this tick, so a long frame can't skip zombies
+            float sweepStartX = mower->rect.x;
+            mower->Update(deltaTime);
+
+            laneHits.clear();
+            laneIndex.QueryLane(mower->row, sweepStartX, mower->rect.x + mower->rect.width, laneHits);
+            for (Zombie* zombie : laneHits) {
+                score += zombie->scoreValue;
+                zombie->health = 0; // Instantly kill zombie
+                zombie->active = false;
+            }
+            if (mower->rect.x > SCREEN_WIDTH + TILE_SIZE) {
+                mower->active = false;
+            }
+        }
+    }
+
+    // Cleanup inactive plants
+    for (const auto& plant : plants) {
+        if (!plant->active) {
+            simEvents.PlantDied(plant->row, plant->rect.x, plant->rect.y, plant->GetType());
+            broadphase.Remove(BroadphaseKind::PLANT, plant->broadphaseId);
+            plant->CancelTimers(timerWheel);
+        }
+    }
+    plants.erase(std::remove_if(plants.begin(), plants.end(),
+                    [](const std::unique_ptr<Plant>& p){ return !p->active; }),
+                    plants.end());
+}
+
+void Simulation::WriteSnapshot(RenderSnapshot& snapshot) const {
+    SimLodCounts& lod = snapshot.lod;
+    lod = { 0, 0, 0, 0 };
+    snapshot.sprites.clear();
+    for (const auto& plant : plants) {
+        if (!plant->active) continue;
+        snapshot.sprites.push_back({ SpriteLayer::PLANTS, plant->row, plant->archetype->sprite,
+                                     animations.GetFrame(plant->clip, clock - plant->animPhase), plant->rect });
+    }
+    for (const auto& zombie : zombies) {
+        if (!zombie->active) continue;
+        if (zombie->dormant) {
+            lod.dormantZombies++;
+            lod.culledSprites++;
+            continue;
+        }
+        lod.awakeZombies++;
+        snapshot.sprites.push_back({ SpriteLayer::ZOMBIES, zombie->row, GetZombieArchetype(zombie->GetType()).sprite,
+                                     animations.GetFrame(zombie->clip, clock - zombie->animPhase), zombie->rect });
+    }
+    projectiles.AppendSprites(animations, clock, snapshot.sprites);
+    for (const auto& mower : lawnmowers) {
+        if (mower->active) {
+            const Texture2D& texture = mower->texture;
+            snapshot.sprites.push_back({ SpriteLayer::MOWERS, mower->row, SpriteId::LAWNMOWER, { 0, 0, (float)texture.width, (float)texture.height },
+                                         { mower->rect.x, mower->rect.y, (float)texture.width, (float)texture.height } });
+        }
+    }
+
+    // Awake zombies just right of the screen and mowers leaving it are not drawn either
+    const Rectangle screen = { 0, 0, (float)SCREEN_WIDTH, (float)SCREEN_HEIGHT };
+    size_t kept = 0;
+    for (const SpriteInstance& sprite : snapshot.sprites) {
+        if (CheckCollisionRecs(sprite.dest, screen)) snapshot.sprites[kept++] = sprite;
+    }
+    lod.culledSprites += (int)(snapshot.sprites.size() - kept);
+    snapshot.sprites.resize(kept);
+    lod.drawnSprites = (int)kept;
+
+    snapshot.sunCurrency = sunCurrency;
+    snapshot.score = score;
+    snapshot.level = level;
+    snapshot.targetScore = targetScore;
+    snapshot.status = status;
+    snapshot.generation = generation;
+    snapshot.tick = tickCount;
+}
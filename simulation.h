@@ -0,0 +1,123 @@
+// simulation.h
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "raylib.h"
+#include <vector>
+#include <memory> // For std::unique_ptr
+#include "plant.h"
+#include "zombie.h"
+#include "projectile.h"
+#include "lawnmower.h"
+#include "lane_index.h"
+#include "contact_scheduler.h"
+#include "broadphase.h"
+#include "timer_wheel.h"
+#include "status_effects.h"
+#include "sim_context.h"
+#include "sim_events.h"
+#include "render_snapshot.h"
+#include "animation.h"
+
+//----------------------------------------------------------------------------------
+// Simulation
+// The whole gameplay state of a level and the fixed-step tick that advances it.
+// It is owned by the simulation thread (see sim_thread.h): the main thread only
+// talks to it through SimCommands and only reads it through RenderSnapshots.
+//----------------------------------------------------------------------------------
+enum class SimCommandType {
+    RESET_LEVEL, // value: level to start, leaves the simulation stopped
+    SET_RUNNING, // value: 1 to run, 0 to stop (pause, menus)
+    PLACE_PLANT, // row, col, plantType; skipped if the tile is taken or the sun is short
+    DIG_PLANT    // row, col
+};
+
+struct SimCommand {
+    SimCommandType type;
+    int row;
+    int col;
+    PlantType plantType;
+    int value;
+};
+
+// Views sized like their atlas sprites: the animation frames are baked from them,
+// so frame rects come out relative to the sprite. The simulation never draws.
+struct SimTextures {
+    Texture2D plants[(int)PlantType::NONE]; // Indexed by PlantType, SHOVEL unused
+    Texture2D regularZombie;
+    Texture2D jumpingZombie;
+    Texture2D lawnmower;
+    Texture2D projectiles[(int)ProjectileType::FROZEN + 1]; // Indexed by ProjectileType
+};
+
+int CalculateTargetScore(int level);
+
+// Totals since the simulation was created
+struct SimLodStats {
+    unsigned long long zombieUpdates;    // Full updates of awake zombies
+    unsigned long long dormantSkips;     // Per-tick updates skipped for dormant zombies
+    unsigned long long coarseSteps;      // Coarse steps taken instead
+    unsigned long long wakeUps;
+};
+
+class Simulation {
+public:
+    explicit Simulation(const SimTextures& textures);
+
+    void Apply(const SimCommand& command);
+    // One fixed step of gameplay, only while RUNNING. Stops itself on level completion or game over.
+    void Tick(float deltaTime);
+    void WriteSnapshot(RenderSnapshot& snapshot) const;
+
+    bool IsRunning() const { return status == SimStatus::RUNNING; }
+    unsigned long long GetTickCount() const { return tickCount; }
+    const SimLodStats& GetLodStats() const { return lodStats; }
+    // Filled during Apply and Tick, the simulation thread forwards and clears it
+    SimEvents& GetEvents() { return simEvents; }
+
+private:
+    void Reset(int level);
+    void PlacePlant(int row, int col, PlantType type);
+    void DigPlant(int row, int col);
+    void SpawnZombie(float x, int spawnRow);
+    void CatchUpDormantZombie(Zombie* zombie);
+    void StepDormantZombie(Zombie* zombie);
+    void WakeZombie(Zombie* zombie);
+    void WakeRow(int row);
+
+    SimTextures textures;
+    AnimationTable animations; // Baked from 'textures' once, shared by every entity
+
+    std::vector<std::unique_ptr<Plant>> plants;
+    std::vector<std::unique_ptr<Zombie>> zombies;
+    ProjectileLanes projectiles;
+    std::vector<std::unique_ptr<LawnMower>> lawnmowers;
+    LaneIndex laneIndex;
+    Broadphase broadphase;
+    ContactScheduler contactScheduler;
+    TimerWheel timerWheel; // Every plant and zombie deadline lives here
+    StatusEffects statusEffects; // Slow, freeze, burn and stun on zombies
+    SimEvents simEvents;
+    int sunCurrency;
+    float clock;        // Seconds of gameplay since the level started, drives every animation
+    SimContext context; // Refers to the members above, so declared after them
+
+    // Scratch buffers, reused every tick
+    std::vector<BroadphasePair> broadphasePairs;
+    std::vector<Zombie*> laneHits;
+    std::vector<ProjectileHit> projectileHits;
+    std::vector<FiredTimer> firedTimers;
+
+    int score;
+    int level;
+    int targetScore;
+    float zombieSpawnTimer;
+    float zombieSpawnRate;
+    SimStatus status;
+    int generation;
+    unsigned long long tickCount;
+    unsigned long long zombieMoves; // Zombie update passes so far, dormant zombies catch up to it
+    SimLodStats lodStats;
+};
+
+#endif // SIMULATION_H
@@ -0,0 +1,26 @@
+// soft_font.h
+#ifndef SOFT_FONT_H
+#define SOFT_FONT_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Soft Font
+// raylib's default font, rebuilt on the CPU for the software render device.
+// raylib only creates it in InitWindow, through a function the raylib DLL does
+// not export, and uploads it to the GPU; without a window GetFontDefault is
+// empty. Its bitmap and glyph widths are kept here as in raylib's rtext.c and
+// laid out the same way, so headless frames show the same glyphs at the same
+// metrics as the window.
+//----------------------------------------------------------------------------------
+const int SOFT_FONT_ATLAS_SIZE = 128;
+const int SOFT_FONT_GLYPH_COUNT = 224;    // Codepoints 32 to 255
+const int SOFT_FONT_GLYPH_HEIGHT = 10;
+
+// Glyph metrics and recs into 'outAtlas', which receives the glyphs as a
+// SOFT_FONT_ATLAS_SIZE square image. The font's texture and glyph images stay
+// empty: upload 'outAtlas' as the texture.
+Font LoadSoftFont(Image& outAtlas);
+void UnloadSoftFont(Font& font);
+
+#endif // SOFT_FONT_H
@@ -0,0 +1,313 @@
+// soft_raster.cpp
+#include "soft_raster.h"
+#include <algorithm> // For std::min, std::max
+#include <chrono>
+#include <cmath>     // For floorf, ceilf
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOFT_RASTER_SSE2
+#endif
+
+namespace {
+    // x / 255 rounded, exact for x in [0, 255 * 255]. The scalar and SSE2 paths
+    // round identically, so a pixel's value doesn't depend on its place in a span.
+    inline int Div255(int x) {
+        x += 128;
+        return (x + (x >> 8)) >> 8;
+    }
+
+#ifdef SOFT_RASTER_SSE2
+    // Div255 on eight 16-bit lanes
+    inline __m128i Div255(__m128i x) {
+        x = _mm_add_epi16(x, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    // Both pixels' alpha (lanes 3 and 7) copied to all four of their lanes
+    inline __m128i BroadcastAlpha(__m128i pixels16) {
+        return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    }
+#endif
+
+    bool IsWhite(Color c) { return c.r == 255 && c.g == 255 && c.b == 255 && c.a == 255; }
+}
+
+//----------------------------------------------------------------------------------
+// Span Kernels
+//----------------------------------------------------------------------------------
+void SoftModulateSpanScalar(Color* span, int count, Color tint) {
+    for (int i = 0; i < count; ++i) {
+        Color& c = span[i];
+        c = { (unsigned char)Div255(c.r * tint.r), (unsigned char)Div255(c.g * tint.g),
+              (unsigned char)Div255(c.b * tint.b), (unsigned char)Div255(c.a * tint.a) };
+    }
+}
+
+void SoftBlendSpanScalar(Color* dst, const Color* src, int count) {
+    for (int i = 0; i < count; ++i) {
+        const Color& s = src[i];
+        Color& d = dst[i];
+        int a = s.a;
+        if (a == 0) continue;
+        if (a == 255) { d = s; continue; }
+        int x = 255 - a;
+        d = { (unsigned char)Div255(s.r * a + d.r * x), (unsigned char)Div255(s.g * a + d.g * x),
+              (unsigned char)Div255(s.b * a + d.b * x), (unsigned char)Div255(255 * a + d.a * x) };
+    }
+}
+
+void SoftModulateSpan(Color* span, int count, Color tint) {
+    int i = 0;
+#ifdef SOFT_RASTER_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i tint16 = _mm_set_epi16(tint.a, tint.b, tint.g, tint.r, tint.a, tint.b, tint.g, tint.r);
+    for (; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(span + i));
+        __m128i lo = Div255(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), tint16));
+        __m128i hi = Div255(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), tint16));
+        _mm_storeu_si128((__m128i*)(span + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    SoftModulateSpanScalar(span + i, count - i, tint);
+}
+
+void SoftBlendSpan(Color* dst, const Color* src, int count) {
+    int i = 0;
+#ifdef SOFT_RASTER_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i alphaLanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    for (; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i sLo = _mm_unpacklo_epi8(s, zero);
+        __m128i sHi = _mm_unpackhi_epi8(s, zero);
+        __m128i aLo = BroadcastAlpha(sLo);
+        __m128i aHi = BroadcastAlpha(sHi);
+        // The source's own alpha counts as 255 in the alpha lane: a + d.a * (255 - a) / 255
+        sLo = _mm_or_si128(sLo, alphaLanes);
+        sHi = _mm_or_si128(sHi, alphaLanes);
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(sLo, aLo), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(full, aLo)));
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(sHi, aHi), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(full, aHi)));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(Div255(lo), Div255(hi)));
+    }
+#endif
+    SoftBlendSpanScalar(dst + i, src + i, count - i);
+}
+
+bool SoftHasSimdSpans() {
+#ifdef SOFT_RASTER_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Software Rasterizer Implementation
+//----------------------------------------------------------------------------------
+SoftRasterizer::SoftRasterizer(int width, int height, int threads)
+    : width(width), height(height),
+      tilesX((width + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE), tilesY((height + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE),
+      pixels((size_t)width * height, BLACK), cleared(false), clearColor(BLACK), mainSpan(SOFT_TILE_SIZE),
+      frameSerial(0), busyWorkers(0), stopping(false), nextTile(0), frameStats{ 0, 0, 0.0f }
+{
+    if (threads < 0) threads = std::max(0, (int)std::thread::hardware_concurrency() - 1);
+    for (int i = 0; i < threads; ++i) workers.emplace_back(&SoftRasterizer::WorkerLoop, this);
+}
+
+SoftRasterizer::~SoftRasterizer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+unsigned int SoftRasterizer::AddTexture(const Image& image) {
+    if (image.data == nullptr || image.width <= 0 || image.height <= 0) return 0;
+
+    size_t slot = 0;
+    while (slot < textures.size() && !textures[slot].texels.empty()) ++slot;
+    if (slot == textures.size()) textures.push_back(SoftTexture());
+
+    SoftTexture& texture = textures[slot];
+    texture.width = image.width;
+    texture.height = image.height;
+    Color* colors = LoadImageColors(image); // Any pixel format, as RGBA8
+    texture.texels.assign(colors, colors + (size_t)image.width * image.height);
+    UnloadImageColors(colors);
+    return (unsigned int)slot + 1;
+}
+
+void SoftRasterizer::RemoveTexture(unsigned int id) {
+    if (id == 0 || id > textures.size()) return;
+    std::vector<Color>().swap(textures[id - 1].texels);
+}
+
+void SoftRasterizer::Begin() {
+    commands.clear();
+    cleared = false;
+}
+
+void SoftRasterizer::Clear(Color color) {
+    commands.clear();
+    cleared = true;
+    clearColor = color;
+}
+
+void SoftRasterizer::DrawQuad(unsigned int texture, float u0, float v0, float u1, float v1, Rectangle dest, Color tint) {
+    if (tint.a == 0 || dest.width <= 0 || dest.height <= 0) return;
+    if (texture != 0 && (texture > textures.size() || textures[texture - 1].texels.empty())) return;
+
+    // Pixels whose centers lie inside 'dest', the same coverage rule as the GPU
+    Command command;
+    command.x0 = std::max(0, (int)ceilf(dest.x - 0.5f));
+    command.y0 = std::max(0, (int)ceilf(dest.y - 0.5f));
+    command.x1 = std::min(width, (int)ceilf(dest.x + dest.width - 0.5f));
+    command.y1 = std::min(height, (int)ceilf(dest.y + dest.height - 0.5f));
+    if (command.x0 >= command.x1 || command.y0 >= command.y1) return;
+
+    command.texture = texture;
+    command.u0 = u0;
+    command.v0 = v0;
+    command.u1 = u1;
+    command.v1 = v1;
+    command.dest = dest;
+    command.tint = tint;
+    commands.push_back(command);
+}
+
+void SoftRasterizer::End() {
+    auto start = std::chrono::steady_clock::now();
+
+    BinCommands();
+    nextTile.store(0);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++frameSerial;
+        busyWorkers = (int)workers.size();
+    }
+    wake.notify_all();
+    RasterTiles(mainSpan);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return busyWorkers == 0; });
+    }
+
+    frameStats.commands = (int)commands.size();
+    frameStats.tileCommands = (int)tileCommands.size();
+    frameStats.rasterMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Count per tile, prefix sum into start offsets, then fill in submission order
+void SoftRasterizer::BinCommands() {
+    int tileCount = tilesX * tilesY;
+    tileStart.assign(tileCount + 1, 0);
+    for (const Command& command : commands) {
+        for (int ty = command.y0 / SOFT_TILE_SIZE; ty <= (command.y1 - 1) / SOFT_TILE_SIZE; ++ty) {
+            for (int tx = command.x0 / SOFT_TILE_SIZE; tx <= (command.x1 - 1) / SOFT_TILE_SIZE; ++tx) {
+                tileStart[ty * tilesX + tx + 1]++;
+            }
+        }
+    }
+    for (int tile = 0; tile < tileCount; ++tile) tileStart[tile + 1] += tileStart[tile];
+
+    tileCommands.resize(tileStart[tileCount]);
+    std::vector<int> filled(tileStart.begin(), tileStart.end() - 1);
+    for (int i = 0; i < (int)commands.size(); ++i) {
+        const Command& command = commands[i];
+        for (int ty = command.y0 / SOFT_TILE_SIZE; ty <= (command.y1 - 1) / SOFT_TILE_SIZE; ++ty) {
+            for (int tx = command.x0 / SOFT_TILE_SIZE; tx <= (command.x1 - 1) / SOFT_TILE_SIZE; ++tx) {
+                tileCommands[filled[ty * tilesX + tx]++] = i;
+            }
+        }
+    }
+}
+
+// Takes tiles until none are left; every thread runs this, the main one included
+void SoftRasterizer::RasterTiles(std::vector<Color>& span) {
+    int tileCount = tilesX * tilesY;
+    for (int tile = nextTile.fetch_add(1); tile < tileCount; tile = nextTile.fetch_add(1)) {
+        RasterTile(tile, span);
+    }
+}
+
+void SoftRasterizer::RasterTile(int tile, std::vector<Color>& span) {
+    int tileX0 = (tile % tilesX) * SOFT_TILE_SIZE;
+    int tileY0 = (tile / tilesX) * SOFT_TILE_SIZE;
+    int tileX1 = std::min(tileX0 + SOFT_TILE_SIZE, width);
+    int tileY1 = std::min(tileY0 + SOFT_TILE_SIZE, height);
+
+    if (cleared) {
+        for (int y = tileY0; y < tileY1; ++y) {
+            std::fill(pixels.begin() + (size_t)y * width + tileX0, pixels.begin() + (size_t)y * width + tileX1, clearColor);
+        }
+    }
+    for (int i = tileStart[tile]; i < tileStart[tile + 1]; ++i) {
+        const Command& command = commands[tileCommands[i]];
+        int x0 = std::max(command.x0, tileX0);
+        int x1 = std::min(command.x1, tileX1);
+        int y0 = std::max(command.y0, tileY0);
+        int y1 = std::min(command.y1, tileY1);
+        for (int y = y0; y < y1; ++y) DrawSpan(command, y, x0, x1, span.data());
+    }
+}
+
+// One row of a quad, at most a tile wide: sample into 'span', tint, blend
+void SoftRasterizer::DrawSpan(const Command& command, int y, int x0, int x1, Color* span) {
+    int count = x1 - x0;
+    Color* dst = &pixels[(size_t)y * width + x0];
+
+    if (command.texture == 0) {
+        std::fill(span, span + count, command.tint);
+        SoftBlendSpan(dst, span, count);
+        return;
+    }
+
+    const SoftTexture& texture = textures[command.texture - 1];
+    const Rectangle& dest = command.dest;
+    float v = command.v0 + (y + 0.5f - dest.y) / dest.height * (command.v1 - command.v0);
+    int texelY = std::min(std::max((int)floorf(v * texture.height), 0), texture.height - 1);
+    const Color* row = &texture.texels[(size_t)texelY * texture.width];
+
+    // Stepped from the quad's first column, never accumulated: a pixel samples the
+    // same texel whichever tile it falls in
+    float du = (command.u1 - command.u0) / dest.width * texture.width;
+    float u = command.u0 * texture.width + (command.x0 + 0.5f - dest.x) * du;
+    for (int i = 0, column = x0 - command.x0; i < count; ++i, ++column) {
+        int texelX = std::min(std::max((int)floorf(u + column * du), 0), texture.width - 1);
+        span[i] = row[texelX];
+    }
+    if (!IsWhite(command.tint)) SoftModulateSpan(span, count, command.tint);
+    SoftBlendSpan(dst, span, count);
+}
+
+void SoftRasterizer::WorkerLoop() {
+    std::vector<Color> span(SOFT_TILE_SIZE);
+    unsigned int seenSerial = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seenSerial] { return stopping || frameSerial != seenSerial; });
+            if (stopping) return;
+            seenSerial = frameSerial;
+        }
+        RasterTiles(span);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busyWorkers == 0) done.notify_one();
+        }
+    }
+}
+
+bool SoftRasterizer::ExportPng(const char* fileName) const {
+    Image image = { (void*)pixels.data(), width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    return ExportImage(image, fileName);
+}
+
+bool SoftRasterizer::ExportRaw(const char* fileName) const {
+    return SaveFileData(fileName, (void*)pixels.data(), (int)(pixels.size() * sizeof(Color)));
+}
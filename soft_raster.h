@@ -0,0 +1,118 @@
+// soft_raster.h
+#ifndef SOFT_RASTER_H
+#define SOFT_RASTER_H
+
+#include "raylib.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+//----------------------------------------------------------------------------------
+// Software Rasterizer
+// Draws the game's subset of 2D primitives, textured and solid quads (outlines
+// and text are built from those), into an RGBA8 framebuffer on the CPU. Frames
+// can then be rendered and captured on machines without a GPU. Textures are
+// plain CPU copies of raylib Images.
+//
+// Draw calls are only recorded. End bins them into SOFT_TILE_SIZE square
+// tiles, then the calling thread and a pool of workers rasterize whole tiles in
+// parallel. A tile replays its own commands in submission order, so the result
+// is the same as drawing them one by one. Texels are sampled nearest-neighbour
+// (raylib's default filter), spans are tinted and alpha blended four pixels at
+// a time with SSE2 where available.
+//----------------------------------------------------------------------------------
+const int SOFT_TILE_SIZE = 64; // Pixels
+
+// Span kernels. The SIMD versions take whole groups of four pixels and hand the
+// rest to the scalar ones, which must round the same way; tools/check_soft_raster
+// compares them.
+void SoftModulateSpan(Color* span, int count, Color tint);   // span *= tint, per channel
+void SoftBlendSpan(Color* dst, const Color* src, int count);  // dst = src over dst
+void SoftModulateSpanScalar(Color* span, int count, Color tint);
+void SoftBlendSpanScalar(Color* dst, const Color* src, int count);
+bool SoftHasSimdSpans(); // False when the SIMD versions are the scalar ones
+
+struct SoftFrameStats {
+    int commands;       // Recorded since the last Clear
+    int tileCommands;   // Command replays summed over all tiles
+    float rasterMs;     // Wall time of End
+};
+
+class SoftRasterizer {
+public:
+    // 'threads' workers besides the thread calling End, -1 for one per other hardware thread
+    SoftRasterizer(int width, int height, int threads = -1);
+    ~SoftRasterizer();
+
+    // Copies the image as RGBA8; returns the id to draw with, 0 if it has no pixels
+    unsigned int AddTexture(const Image& image);
+    void RemoveTexture(unsigned int id);
+
+    void Begin();
+    // Fills the framebuffer, drawing recorded before it is dropped
+    void Clear(Color color);
+    // Texture coordinates are normalized like rlTexCoord2f, u1 < u0 mirrors the
+    // quad; texture 0 draws a solid quad of 'tint'
+    void DrawQuad(unsigned int texture, float u0, float v0, float u1, float v1, Rectangle dest, Color tint);
+    // Rasterizes everything recorded since Begin
+    void End();
+
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+    const Color* GetPixels() const { return pixels.data(); }
+    const SoftFrameStats& GetFrameStats() const { return frameStats; }
+
+    bool ExportPng(const char* fileName) const;
+    bool ExportRaw(const char* fileName) const; // Width * height RGBA8 pixels, top row first
+
+private:
+    struct SoftTexture {
+        int width;
+        int height;
+        std::vector<Color> texels; // Empty for a free slot
+    };
+
+    struct Command {
+        unsigned int texture;
+        float u0, v0, u1, v1;
+        Rectangle dest;
+        int x0, y0, x1, y1; // Covered pixels [x0, x1) x [y0, y1), clipped to the framebuffer
+        Color tint;
+    };
+
+    void BinCommands();
+    void RasterTiles(std::vector<Color>& span);
+    void RasterTile(int tile, std::vector<Color>& span);
+    void DrawSpan(const Command& command, int y, int x0, int x1, Color* span);
+    void WorkerLoop();
+
+    int width;
+    int height;
+    int tilesX;
+    int tilesY;
+    std::vector<Color> pixels;
+    std::vector<SoftTexture> textures; // Indexed by id - 1
+
+    bool cleared;                      // Clear was called this frame
+    Color clearColor;
+    std::vector<Command> commands;
+    std::vector<int> tileStart;        // Tile t replays tileCommands[tileStart[t] .. tileStart[t + 1])
+    std::vector<int> tileCommands;
+    std::vector<Color> mainSpan;       // Scratch of the thread calling End
+
+    // Worker pool, woken once per End
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    unsigned int frameSerial;          // Bumped by End, workers start when it changes
+    int busyWorkers;
+    bool stopping;
+    std::atomic<int> nextTile;
+
+    SoftFrameStats frameStats;
+};
+
+#endif // SOFT_RASTER_H
@@ -0,0 +1,131 @@
+// sprite_batch.cpp
+#include "sprite_batch.h"
+#include "rlgl.h"
+#include "render_device.h"
+#include <algorithm> // For std::max, std::min
+
+namespace {
+    const int RADIX_BITS = 8;
+    const int RADIX_BUCKETS = 1 << RADIX_BITS;
+    const int RADIX_PASSES = 32 / RADIX_BITS;
+}
+
+//----------------------------------------------------------------------------------
+// Sprite Batch Implementation
+//----------------------------------------------------------------------------------
+SpriteBatch::SpriteBatch()
+    : frameStats{ 0, 0 }, peakStats{ 0, 0 }
+{
+}
+
+void SpriteBatch::Begin() {
+    quads.clear();
+    entries.clear();
+}
+
+void SpriteBatch::Add(SpriteLayer layer, int depth, const Texture2D& texture, Rectangle source, Rectangle dest, Color tint) {
+    if (texture.id == 0 || texture.width <= 0 || texture.height <= 0) return;
+
+    // Two texture ids sharing their low 12 bits only interleave, the draw calls
+    // still follow the actual id of each quad
+    depth = std::min(std::max(depth, 0), SPRITE_MAX_DEPTH);
+    unsigned int key = ((unsigned int)depth << 16) | ((unsigned int)layer << 12) | (texture.id & 0x0FFFu);
+    entries.push_back({ key, (unsigned int)quads.size() });
+
+    Quad quad;
+    quad.textureId = texture.id;
+    quad.u0 = source.x / texture.width;
+    quad.v0 = source.y / texture.height;
+    quad.u1 = (source.x + source.width) / texture.width;
+    quad.v1 = (source.y + source.height) / texture.height;
+    quad.dest = dest;
+    quad.tint = tint;
+    quads.push_back(quad);
+}
+
+void SpriteBatch::End() {
+    frameStats = { (int)quads.size(), 0 };
+    if (quads.empty()) return;
+
+    SortEntries();
+    if (RenderIsSoftware()) {
+        EndSoftware();
+    } else {
+        EndRlgl();
+    }
+    peakStats.quads = std::max(peakStats.quads, frameStats.quads);
+    peakStats.drawCalls = std::max(peakStats.drawCalls, frameStats.drawCalls);
+}
+
+void SpriteBatch::EndRlgl() {
+    unsigned int currentTexture = 0;
+    for (const SortEntry& entry : entries) {
+        const Quad& quad = quads[entry.quad];
+        if (quad.textureId != currentTexture) {
+            if (currentTexture != 0) rlEnd();
+            currentTexture = quad.textureId;
+            rlSetTexture(currentTexture); // A new draw call inside rlgl's batch
+            rlBegin(RL_QUADS);
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+            frameStats.drawCalls++;
+        }
+        // The rlgl buffer is flushed when full, which costs one more draw call
+        if (rlCheckRenderBatchLimit(4)) frameStats.drawCalls++;
+
+        const Rectangle& d = quad.dest;
+        rlColor4ub(quad.tint.r, quad.tint.g, quad.tint.b, quad.tint.a);
+        // Counter-clockwise, the winding raylib's quads use
+        rlTexCoord2f(quad.u0, quad.v0); rlVertex2f(d.x, d.y);
+        rlTexCoord2f(quad.u0, quad.v1); rlVertex2f(d.x, d.y + d.height);
+        rlTexCoord2f(quad.u1, quad.v1); rlVertex2f(d.x + d.width, d.y + d.height);
+        rlTexCoord2f(quad.u1, quad.v0); rlVertex2f(d.x + d.width, d.y);
+    }
+    rlEnd();
+    rlSetTexture(0);
+}
+
+// Same order to the software rasterizer; a texture run still counts as a draw call
+void SpriteBatch::EndSoftware() {
+    SoftRasterizer* soft = RenderGetSoftRasterizer();
+    unsigned int currentTexture = 0;
+    for (const SortEntry& entry : entries) {
+        const Quad& quad = quads[entry.quad];
+        if (quad.textureId != currentTexture) {
+            currentTexture = quad.textureId;
+            frameStats.drawCalls++;
+        }
+        soft->DrawQuad(quad.textureId, quad.u0, quad.v0, quad.u1, quad.v1, quad.dest, quad.tint);
+    }
+}
+
+// LSD radix sort, stable, so equal keys stay in submission order. A pass whose
+// digit is the same for every key (often the depth's high byte) is skipped.
+void SpriteBatch::SortEntries() {
+    size_t count = entries.size();
+    sortScratch.resize(count);
+
+    unsigned int histograms[RADIX_PASSES][RADIX_BUCKETS] = {};
+    for (const SortEntry& entry : entries) {
+        for (int pass = 0; pass < RADIX_PASSES; ++pass) {
+            histograms[pass][(entry.key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+        }
+    }
+
+    for (int pass = 0; pass < RADIX_PASSES; ++pass) {
+        unsigned int* histogram = histograms[pass];
+        int shift = pass * RADIX_BITS;
+        if (histogram[(entries[0].key >> shift) & (RADIX_BUCKETS - 1)] == count) continue;
+
+        // Bucket counts become start offsets
+        unsigned int offset = 0;
+        for (int bucket = 0; bucket < RADIX_BUCKETS; ++bucket) {
+            unsigned int bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (const SortEntry& entry : entries) {
+            sortScratch[histogram[(entry.key >> shift) & (RADIX_BUCKETS - 1)]++] = entry;
+        }
+        entries.swap(sortScratch);
+    }
+}
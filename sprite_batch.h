@@ -0,0 +1,77 @@
+// sprite_batch.h
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include "raylib.h"
+#include <vector>
+
+//----------------------------------------------------------------------------------
+// Sprite Batch
+// Collects textured quads for a frame and submits them straight to rlgl's vertex
+// buffer. Every run of quads sharing a texture becomes a single draw call,
+// instead of one raylib immediate-mode call (with its own state setup) per sprite.
+//
+// Quads are drawn by depth first, so a lane further down the lawn overlaps the
+// one above it whatever the object types, then by layer inside a depth, then
+// grouped by texture. Quads with equal keys keep their submission order. The
+// 32-bit keys are radix sorted, a few linear passes even for thousands of quads.
+// On the software render device the sorted quads go to the SoftRasterizer.
+//----------------------------------------------------------------------------------
+// Order inside one depth
+enum class SpriteLayer {
+    PLANTS,
+    ZOMBIES,
+    PROJECTILES,
+    MOWERS,
+    HUD,
+    COUNT
+};
+
+const int SPRITE_MAX_DEPTH = 0xFFFF; // Depths are clamped to [0, SPRITE_MAX_DEPTH]
+
+struct SpriteBatchStats {
+    int quads;     // Quads submitted
+    int drawCalls; // Texture runs plus the flushes forced by a full rlgl buffer
+};
+
+class SpriteBatch {
+public:
+    SpriteBatch();
+
+    void Begin();
+    // 'depth' grows down the screen (the lane for lawn objects); 'source' in texture
+    // pixels, like DrawTexturePro without origin and rotation
+    void Add(SpriteLayer layer, int depth, const Texture2D& texture, Rectangle source, Rectangle dest, Color tint);
+    // Sorts and submits everything added since Begin
+    void End();
+
+    const SpriteBatchStats& GetFrameStats() const { return frameStats; } // Last End
+    const SpriteBatchStats& GetPeakStats() const { return peakStats; }
+
+private:
+    struct Quad {
+        unsigned int textureId;
+        float u0, v0, u1, v1;   // Normalized texture coordinates
+        Rectangle dest;
+        Color tint;
+    };
+
+    struct SortEntry {
+        unsigned int key;   // Depth (16 bits), layer (4), low bits of the texture id (12)
+        unsigned int quad;  // Index into 'quads'
+    };
+
+    void SortEntries();
+    // Submit the sorted quads, to rlgl or to the software device
+    void EndRlgl();
+    void EndSoftware();
+
+    // All reused from frame to frame
+    std::vector<Quad> quads;               // Submission order
+    std::vector<SortEntry> entries;
+    std::vector<SortEntry> sortScratch;
+    SpriteBatchStats frameStats;
+    SpriteBatchStats peakStats;
+};
+
+#endif // SPRITE_BATCH_H
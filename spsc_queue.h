@@ -0,0 +1,46 @@
+// spsc_queue.h
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef> // For size_t
+
+//----------------------------------------------------------------------------------
+// SPSC Queue
+// Fixed-capacity FIFO between exactly one producer thread and one consumer
+// thread, no locks. Each side only writes its own index; the acquire/release
+// pair on the indices publishes the element itself. Push fails instead of
+// waiting when the queue is full, Pop fails when it is empty.
+//----------------------------------------------------------------------------------
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    // Producer side
+    bool Push(const T& value) {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) >= Capacity) return false;
+        slots[currentTail & (Capacity - 1)] = value;
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool Pop(T& value) {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) return false;
+        value = slots[currentHead & (Capacity - 1)];
+        head.store(currentHead + 1, std::memory_order_release); // Hands the slot back to the producer
+        return true;
+    }
+
+private:
+    T slots[Capacity];
+    alignas(64) std::atomic<size_t> head; // Next element to pop, written by the consumer
+    alignas(64) std::atomic<size_t> tail; // Next free slot, written by the producer
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,132 @@
+// status_effects.cpp
+#include "status_effects.h"
+#include "zombie.h"
+#include <cmath> // For std::pow
+
+//----------------------------------------------------------------------------------
+// Status Effects Implementation
+//----------------------------------------------------------------------------------
+void StatusEffects::Apply(Zombie* zombie, StatusEffectType type) {
+    if (!zombie->active) return;
+
+    const StatusEffectRule& rule = STATUS_EFFECT_RULES[(int)type];
+    int row = zombie->statusRows[(int)type];
+    if (row < 0) {
+        AddRow(zombie, type);
+        RecomputeSpeed(zombie);
+        return;
+    }
+
+    switch (rule.stacking) {
+        case StatusStacking::IGNORE:
+            break;
+        case StatusStacking::REFRESH:
+            remaining[row] = rule.duration;
+            break;
+        case StatusStacking::STACK:
+            remaining[row] = rule.duration;
+            if (stacks[row] < rule.maxStacks) {
+                stacks[row]++;
+                damagePerSecond[row] = rule.damagePerSecond * stacks[row];
+                RecomputeSpeed(zombie);
+            }
+            break;
+    }
+}
+
+void StatusEffects::AddRow(Zombie* zombie, StatusEffectType type) {
+    const StatusEffectRule& rule = STATUS_EFFECT_RULES[(int)type];
+    zombie->statusRows[(int)type] = (int)owners.size();
+    zombie->statusMask |= 1u << (int)type;
+
+    owners.push_back(zombie);
+    types.push_back(type);
+    remaining.push_back(rule.duration);
+    damagePerSecond.push_back(rule.damagePerSecond);
+    damageCarry.push_back(0.0f);
+    stacks.push_back(1);
+}
+
+void StatusEffects::RemoveRow(size_t row) {
+    Zombie* zombie = owners[row];
+    zombie->statusRows[(int)types[row]] = -1;
+    zombie->statusMask &= ~(1u << (int)types[row]);
+
+    // Swap with the last row so the arrays stay dense
+    size_t last = owners.size() - 1;
+    if (row != last) {
+        owners[row] = owners[last];
+        types[row] = types[last];
+        remaining[row] = remaining[last];
+        damagePerSecond[row] = damagePerSecond[last];
+        damageCarry[row] = damageCarry[last];
+        stacks[row] = stacks[last];
+        owners[row]->statusRows[(int)types[row]] = (int)row;
+    }
+    owners.pop_back();
+    types.pop_back();
+    remaining.pop_back();
+    damagePerSecond.pop_back();
+    damageCarry.pop_back();
+    stacks.pop_back();
+}
+
+void StatusEffects::RecomputeSpeed(Zombie* zombie) {
+    float modifier = 1.0f;
+    for (int type = 0; type < (int)StatusEffectType::COUNT; ++type) {
+        int row = zombie->statusRows[type];
+        if (row >= 0) modifier *= std::pow(STATUS_EFFECT_RULES[type].speedModifier, (float)stacks[row]);
+    }
+    zombie->speed = zombie->baseSpeed * modifier;
+    zombie->RequestContactCheck(); // Arrival time changed with the speed
+}
+
+void StatusEffects::Remove(Zombie* zombie) {
+    if (zombie->statusMask == 0) return;
+    for (int type = 0; type < (int)StatusEffectType::COUNT; ++type) {
+        if (zombie->statusRows[type] >= 0) RemoveRow((size_t)zombie->statusRows[type]);
+    }
+}
+
+void StatusEffects::Clear() {
+    for (Zombie* zombie : owners) {
+        for (int& row : zombie->statusRows) row = -1;
+        zombie->statusMask = 0;
+    }
+    owners.clear();
+    types.clear();
+    remaining.clear();
+    damagePerSecond.clear();
+    damageCarry.clear();
+    stacks.clear();
+}
+
+void StatusEffects::Update(float deltaTime) {
+    const size_t count = remaining.size();
+    if (count == 0) return;
+
+    // Straight loops over contiguous floats, no branches: the compiler vectorizes these
+    float* time = remaining.data();
+    float* carry = damageCarry.data();
+    const float* dps = damagePerSecond.data();
+    for (size_t i = 0; i < count; ++i) time[i] -= deltaTime;
+    for (size_t i = 0; i < count; ++i) carry[i] += dps[i] * deltaTime;
+
+    // Whole points of damage go to health, the fraction carries over to the next tick
+    for (size_t i = 0; i < count; ++i) {
+        if (carry[i] >= 1.0f) {
+            int damage = (int)carry[i];
+            carry[i] -= (float)damage;
+            owners[i]->health -= damage; // Deaths are handled by the zombie loop, like any other damage
+        }
+    }
+
+    // Backwards, so the row swapped in from the end has already been checked
+    for (size_t i = count; i-- > 0;) {
+        if (time[i] <= 0.0f) {
+            Zombie* zombie = owners[i];
+            RemoveRow(i);
+            RecomputeSpeed(zombie);
+        }
+    }
+}
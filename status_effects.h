@@ -0,0 +1,76 @@
+// status_effects.h
+#ifndef STATUS_EFFECTS_H
+#define STATUS_EFFECTS_H
+
+#include <vector>
+#include <cstddef> // For size_t
+
+// Forward declaration, effects are keyed by the zombie they are attached to
+class Zombie;
+
+//----------------------------------------------------------------------------------
+// Status Effects
+// Every active (zombie, effect) pair is one row of parallel arrays, so expiry and
+// burn damage are plain loops over floats. A zombie without effects has no row
+// and is never visited; its speed is only recomputed when an effect starts or ends:
+//     speed = baseSpeed * product of (speedModifier ^ stacks) over its effects
+//----------------------------------------------------------------------------------
+enum class StatusEffectType {
+    SLOW,
+    FREEZE,
+    BURN,
+    STUN,
+    COUNT
+};
+
+// What happens when an effect is applied to a zombie that already has it
+enum class StatusStacking {
+    IGNORE,  // Keeps the running effect untouched
+    REFRESH, // Restarts the duration
+    STACK    // Adds a stack (up to maxStacks) and restarts the duration
+};
+
+struct StatusEffectRule {
+    float speedModifier;   // Multiplies speed per stack, 1 leaves it alone
+    float duration;        // Seconds
+    float damagePerSecond; // Per stack
+    StatusStacking stacking;
+    int maxStacks;
+    bool immobilizes;      // No walking and no eating while active
+};
+
+// Indexed by StatusEffectType
+const StatusEffectRule STATUS_EFFECT_RULES[(int)StatusEffectType::COUNT] = {
+    { 0.5f, 3.0f,  0.0f, StatusStacking::REFRESH, 1, false }, // SLOW (ice peas)
+    { 0.0f, 2.0f,  0.0f, StatusStacking::REFRESH, 1, true  }, // FREEZE
+    { 1.0f, 3.0f, 10.0f, StatusStacking::STACK,   3, false }, // BURN
+    { 0.0f, 1.0f,  0.0f, StatusStacking::IGNORE,  1, true  }, // STUN
+};
+
+class StatusEffects {
+public:
+    void Apply(Zombie* zombie, StatusEffectType type);
+    // Drops every effect of the zombie, call before it is destroyed
+    void Remove(Zombie* zombie);
+    void Clear();
+
+    // Counts every duration down, deals burn damage and expires finished effects
+    void Update(float deltaTime);
+
+    size_t GetActiveCount() const { return remaining.size(); }
+
+private:
+    void AddRow(Zombie* zombie, StatusEffectType type);
+    void RemoveRow(size_t row);
+    void RecomputeSpeed(Zombie* zombie);
+
+    // One entry per active effect, all arrays share the same index
+    std::vector<Zombie*> owners;
+    std::vector<StatusEffectType> types;
+    std::vector<float> remaining;       // Seconds left
+    std::vector<float> damagePerSecond; // Rule damage times stacks, 0 for non damaging effects
+    std::vector<float> damageCarry;     // Fractional damage not yet taken off health
+    std::vector<int> stacks;
+};
+
+#endif // STATUS_EFFECTS_H
@@ -0,0 +1,89 @@
+// text_cache.cpp
+#include "text_cache.h"
+#include "render_device.h"
+
+namespace {
+    // DrawText's own rules: never below the default size, spacing a tenth of the size
+    const int MIN_FONT_SIZE = 10;
+}
+
+//----------------------------------------------------------------------------------
+// Text Cache Implementation
+//----------------------------------------------------------------------------------
+TextCache::TextCache() : layoutCount(0) {}
+
+TextRunId TextCache::Add(const char* text, int fontSize) {
+    TextRun run;
+    run.text = text;
+    run.fontSize = fontSize < MIN_FONT_SIZE ? MIN_FONT_SIZE : fontSize;
+    run.width = 0;
+    run.hasValue = false;
+    run.value = 0;
+    Layout(run);
+    runs.push_back(run);
+    return (TextRunId)runs.size() - 1;
+}
+
+void TextCache::Set(TextRunId id, const char* text) {
+    TextRun& run = runs[id];
+    if (run.text == text) return;
+    run.text = text;
+    Layout(run);
+}
+
+void TextCache::SetInt(TextRunId id, const char* format, int value) {
+    TextRun& run = runs[id];
+    if (run.hasValue && run.value == value) return;
+    run.hasValue = true;
+    run.value = value;
+    Set(id, TextFormat(format, value));
+}
+
+// Mirrors DrawTextEx and DrawTextCodepoint, minus the drawing
+void TextCache::Layout(TextRun& run) {
+    Font font = RenderGetFont();
+    float scale = (float)run.fontSize / font.baseSize;
+    float spacing = (float)(run.fontSize / MIN_FONT_SIZE);
+    float padding = (float)font.glyphPadding;
+
+    run.glyphs.clear();
+    float offsetX = 0.0f;
+    int length = TextLength(run.text.c_str());
+    for (int i = 0; i < length;) {
+        int codepointSize = 0;
+        int codepoint = GetCodepointNext(&run.text[i], &codepointSize);
+        i += codepointSize;
+        int index = GetGlyphIndex(font, codepoint);
+        const Rectangle& rec = font.recs[index];
+        const GlyphInfo& glyph = font.glyphs[index];
+
+        if (codepoint != ' ' && codepoint != '\t') {
+            GlyphQuad quad;
+            quad.source = { rec.x - padding, rec.y - padding, rec.width + 2.0f * padding, rec.height + 2.0f * padding };
+            quad.dest = { offsetX + (glyph.offsetX - padding) * scale, (glyph.offsetY - padding) * scale,
+                          quad.source.width * scale, quad.source.height * scale };
+            run.glyphs.push_back(quad);
+        }
+        offsetX += (glyph.advanceX == 0 ? rec.width : (float)glyph.advanceX) * scale + spacing;
+    }
+    // MeasureText's width: the advances without the spacing after the last glyph
+    run.width = length > 0 ? (int)(offsetX - spacing) : 0;
+    ++layoutCount;
+}
+
+void TextCache::Draw(TextRunId id, int x, int y, Color color) const {
+    Texture2D texture = RenderGetFont().texture;
+    for (const GlyphQuad& glyph : runs[id].glyphs) {
+        Rectangle dest = { x + glyph.dest.x, y + glyph.dest.y, glyph.dest.width, glyph.dest.height };
+        RenderTexturedRect(texture, glyph.source, dest, color);
+    }
+}
+
+void TextCache::DrawCenteredX(TextRunId id, int centerX, int y, Color color) const {
+    Draw(id, centerX - runs[id].width / 2, y, color);
+}
+
+void TextCache::DrawCentered(TextRunId id, Rectangle box, Color color) const {
+    const TextRun& run = runs[id];
+    Draw(id, (int)(box.x + (box.width - run.width) / 2), (int)(box.y + (box.height - run.fontSize) / 2), color);
+}
@@ -0,0 +1,63 @@
+// text_cache.h
+#ifndef TEXT_CACHE_H
+#define TEXT_CACHE_H
+
+#include "raylib.h"
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------
+// Text Cache
+// DrawText decodes the string, looks every glyph up and works out its position
+// on each call, and centering a label costs a MeasureText on top. Text runs here
+// are laid out once with raylib's default font: the width and, per glyph, the
+// font texture rect and the offset from the run's origin. Drawing a run only
+// emits its quads. Static labels are added at startup; a run showing a number
+// is laid out again only when the number changes. Single line text only.
+//----------------------------------------------------------------------------------
+typedef int TextRunId;
+
+class TextCache {
+public:
+    TextCache();
+
+    // After InitWindow or RenderDeviceInit, either loads the default font
+    TextRunId Add(const char* text, int fontSize);
+    // Lays the run out again if the text differs
+    void Set(TextRunId id, const char* text);
+    // Formats and lays out only when 'value' differs from the last one
+    void SetInt(TextRunId id, const char* format, int value);
+
+    int GetWidth(TextRunId id) const { return runs[id].width; }
+    int GetFontSize(TextRunId id) const { return runs[id].fontSize; }
+    int GetLayoutCount() const { return layoutCount; }
+
+    // Same placement as DrawText(text, x, y, fontSize, color)
+    void Draw(TextRunId id, int x, int y, Color color) const;
+    // Centered horizontally on 'centerX'
+    void DrawCenteredX(TextRunId id, int centerX, int y, Color color) const;
+    // Centered in 'box', the way the buttons center their labels
+    void DrawCentered(TextRunId id, Rectangle box, Color color) const;
+
+private:
+    struct GlyphQuad {
+        Rectangle source; // In the font texture
+        Rectangle dest;   // Relative to the run's origin
+    };
+
+    struct TextRun {
+        std::string text;
+        int fontSize;
+        int width;
+        bool hasValue;    // SetInt was called, 'value' is valid
+        int value;
+        std::vector<GlyphQuad> glyphs;
+    };
+
+    void Layout(TextRun& run);
+
+    std::vector<TextRun> runs; // Indexed by TextRunId
+    int layoutCount;           // Layouts done so far, static labels included
+};
+
+#endif // TEXT_CACHE_H
@@ -0,0 +1,336 @@
+// texture_atlas.cpp
+#include "texture_atlas.h"
+#include "logger.h"
+#include "render_device.h"
+#include "asset_archive.h"
+#include "texture_cache.h"
+#include <algorithm> // For std::sort
+#include <string>
+#include <cstdio>    // For fopen, fprintf, sscanf
+#include <cstring>   // For strcmp, memcpy
+
+namespace {
+    // Skyline bottom-left packer: the used area of a page is described by its top
+    // outline, a list of horizontal segments. A rect goes where it ends up lowest.
+    struct SkylineSegment {
+        int x;
+        int y;
+        int width;
+    };
+
+    class SkylinePacker {
+    public:
+        explicit SkylinePacker(int size) : size(size) {
+            skyline.push_back({ 0, 0, size });
+        }
+
+        bool Insert(int width, int height, int& outX, int& outY) {
+            int bestIndex = -1;
+            int bestX = 0;
+            int bestY = size;
+            for (int i = 0; i < (int)skyline.size(); ++i) {
+                int y;
+                if (Fits(i, width, height, y) && (y < bestY || (y == bestY && skyline[i].x < bestX))) {
+                    bestIndex = i;
+                    bestX = skyline[i].x;
+                    bestY = y;
+                }
+            }
+            if (bestIndex < 0) return false;
+
+            // The new segment covers the rect's top, the segments under it shrink or go
+            skyline.insert(skyline.begin() + bestIndex, { bestX, bestY + height, width });
+            int right = bestX + width;
+            for (size_t i = bestIndex + 1; i < skyline.size();) {
+                if (skyline[i].x >= right) break;
+                int overlap = right - skyline[i].x;
+                if (overlap >= skyline[i].width) {
+                    skyline.erase(skyline.begin() + i);
+                    continue;
+                }
+                skyline[i].x += overlap;
+                skyline[i].width -= overlap;
+                break;
+            }
+            // Neighbours at the same height become one segment
+            for (size_t i = 0; i + 1 < skyline.size();) {
+                if (skyline[i].y == skyline[i + 1].y) {
+                    skyline[i].width += skyline[i + 1].width;
+                    skyline.erase(skyline.begin() + i + 1);
+                } else {
+                    ++i;
+                }
+            }
+
+            outX = bestX;
+            outY = bestY;
+            return true;
+        }
+
+    private:
+        // The rect would rest on the highest segment it spans, starting at segment 'index'
+        bool Fits(int index, int width, int height, int& outY) const {
+            if (skyline[index].x + width > size) return false;
+            int y = 0;
+            int remaining = width;
+            for (int i = index; remaining > 0; ++i) {
+                if (i >= (int)skyline.size()) return false;
+                y = std::max(y, skyline[i].y);
+                if (y + height > size) return false;
+                remaining -= skyline[i].width;
+            }
+            outY = y;
+            return true;
+        }
+
+        int size;
+        std::vector<SkylineSegment> skyline; // Left to right, covering the full width
+    };
+
+    // fgets over a string: the next line of 'text' into 'line', false at the end
+    bool NextLine(const std::string& text, size_t& position, char* line, size_t lineSize) {
+        if (position >= text.size()) return false;
+        size_t end = text.find('\n', position);
+        if (end == std::string::npos) end = text.size();
+        size_t length = std::min(end - position, lineSize - 1);
+        memcpy(line, text.data() + position, length);
+        line[length] = '\0';
+        position = end + 1;
+        return true;
+    }
+
+    // Decodes a sprite's source and hashes its bytes, like the texture cache: the
+    // archive entry's hash, or the loose file's. 'outHash' is 0 if it is missing.
+    Image DecodeSprite(const char* fileName, uint64_t& outHash) {
+        outHash = 0;
+        if (ArchiveIsOpen()) {
+            const ArchiveEntry* entry = ArchiveFind(fileName);
+            if (!entry) return ArchiveLoadImage(fileName); // Warns that it was never packed
+            outHash = entry->hash;
+            return LoadImageFromMemory(GetFileExtension(fileName), ArchiveGetData(*entry), (int)entry->size);
+        }
+        int size = 0;
+        unsigned char* data = LoadFileData(fileName, &size);
+        if (!data) return Image{};
+        outHash = ArchiveHash(data, (size_t)size);
+        Image image = LoadImageFromMemory(GetFileExtension(fileName), data, size);
+        UnloadFileData(data);
+        return image;
+    }
+
+    // Same hash without decoding, for checking an imported table against the sources
+    uint64_t SourceHash(const char* fileName) {
+        if (ArchiveIsOpen()) {
+            const ArchiveEntry* entry = ArchiveFind(fileName);
+            return entry ? entry->hash : 0;
+        }
+        int size = 0;
+        unsigned char* data = LoadFileData(fileName, &size);
+        if (!data) return 0;
+        uint64_t hash = ArchiveHash(data, (size_t)size);
+        UnloadFileData(data);
+        return hash;
+    }
+}
+
+std::string AtlasPagePath(const char* tablePath, int page) {
+    std::string base = tablePath;
+    size_t dot = base.find_last_of('.');
+    if (dot != std::string::npos) base.erase(dot);
+    return base + "_" + std::to_string(page) + ".png";
+}
+
+//----------------------------------------------------------------------------------
+// Texture Atlas Implementation
+//----------------------------------------------------------------------------------
+TextureAtlas::TextureAtlas() {
+    for (AtlasSprite& sprite : sprites) sprite = { -1, { 0, 0, 0, 0 } };
+    for (Image& image : spriteImages) image = Image{};
+    for (uint64_t& hash : sourceHashes) hash = 0;
+}
+
+bool TextureAtlas::Pack(int pageSize) {
+    for (int i = 0; i < (int)SpriteId::COUNT; ++i) LoadSprite((SpriteId)i);
+    return PackLoaded(pageSize);
+}
+
+bool TextureAtlas::LoadSprite(SpriteId id) {
+    const SpriteSource& source = SPRITE_SOURCES[(int)id];
+    spriteImages[(int)id] = DecodeSprite(source.fileName, sourceHashes[(int)id]);
+    if (!IsImageValid(spriteImages[(int)id])) {
+        GAME_LOG_WARNING(LogCategory::ASSETS, "Sprite %s missing (%s)", source.name, source.fileName);
+        return false;
+    }
+    return true;
+}
+
+bool TextureAtlas::PackLoaded(int pageSize) {
+    std::vector<int> order;
+    for (int i = 0; i < (int)SpriteId::COUNT; ++i) {
+        if (IsImageValid(spriteImages[i])) order.push_back(i);
+    }
+
+    // Tallest first keeps the skyline flat
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        if (spriteImages[a].height != spriteImages[b].height) return spriteImages[a].height > spriteImages[b].height;
+        return spriteImages[a].width > spriteImages[b].width;
+    });
+
+    std::vector<SkylinePacker> packers;
+    for (int i : order) {
+        int paddedWidth = spriteImages[i].width + ATLAS_PADDING * 2;
+        int paddedHeight = spriteImages[i].height + ATLAS_PADDING * 2;
+        if (paddedWidth > pageSize || paddedHeight > pageSize) {
+            GAME_LOG_WARNING(LogCategory::ASSETS, "Sprite %s is larger than an atlas page", SPRITE_SOURCES[i].name);
+            continue;
+        }
+
+        // First page with room for it, a new one otherwise
+        int x = 0, y = 0;
+        int page = 0;
+        while (page < (int)packers.size() && !packers[page].Insert(paddedWidth, paddedHeight, x, y)) ++page;
+        if (page == (int)packers.size()) {
+            packers.emplace_back(pageSize);
+            pageImages.push_back(GenImageColor(pageSize, pageSize, BLANK));
+            packers.back().Insert(paddedWidth, paddedHeight, x, y);
+        }
+
+        Rectangle source = { (float)(x + ATLAS_PADDING), (float)(y + ATLAS_PADDING), (float)spriteImages[i].width, (float)spriteImages[i].height };
+        ImageDraw(&pageImages[page], spriteImages[i], (Rectangle){ 0, 0, (float)spriteImages[i].width, (float)spriteImages[i].height }, source, WHITE);
+        sprites[i] = { page, source };
+    }
+
+    for (Image& image : spriteImages) {
+        UnloadImage(image);
+        image = Image{};
+    }
+    GAME_LOG_INFO(LogCategory::ASSETS, "Packed %d sprites into %d atlas page(s)", (int)order.size(), (int)pageImages.size());
+    return !pageImages.empty();
+}
+
+bool TextureAtlas::Export(const char* tablePath) const {
+    FILE* file = fopen(tablePath, "w");
+    if (!file) return false;
+
+    fprintf(file, "pages %d\n", (int)pageImages.size());
+    for (int i = 0; i < (int)SpriteId::COUNT; ++i) {
+        const AtlasSprite& sprite = sprites[i];
+        fprintf(file, "%s %d %d %d %d %d %016llx\n", SPRITE_SOURCES[i].name, sprite.page,
+                (int)sprite.source.x, (int)sprite.source.y, (int)sprite.source.width, (int)sprite.source.height,
+                (unsigned long long)sourceHashes[i]);
+    }
+    fclose(file);
+
+    bool exported = true;
+    for (int page = 0; page < (int)pageImages.size(); ++page) {
+        exported = ExportImage(pageImages[page], AtlasPagePath(tablePath, page).c_str()) && exported;
+    }
+    return exported;
+}
+
+bool TextureAtlas::Import(const char* tablePath) {
+    std::string table;
+    if (!ArchiveLoadText(tablePath, table)) return false;
+
+    AtlasSprite imported[(int)SpriteId::COUNT];
+    uint64_t importedHashes[(int)SpriteId::COUNT] = {};
+    bool found[(int)SpriteId::COUNT] = {};
+    int pageCount = 0;
+    size_t position = 0;
+    char line[256];
+    bool valid = NextLine(table, position, line, sizeof(line)) && sscanf(line, "pages %d", &pageCount) == 1 && pageCount > 0;
+    while (valid && NextLine(table, position, line, sizeof(line))) {
+        char name[64];
+        int page, x, y, width, height;
+        unsigned long long hash;
+        if (sscanf(line, "%63s %d %d %d %d %d %llx", name, &page, &x, &y, &width, &height, &hash) != 7) continue;
+        for (int i = 0; i < (int)SpriteId::COUNT; ++i) {
+            if (strcmp(name, SPRITE_SOURCES[i].name) == 0) {
+                imported[i] = { page < pageCount ? page : -1, { (float)x, (float)y, (float)width, (float)height } };
+                importedHashes[i] = hash;
+                found[i] = true;
+                break;
+            }
+        }
+    }
+
+    // A sprite added to SPRITE_SOURCES or a source file edited since the export
+    // (older tables have no hashes at all) means the atlas is stale
+    for (int i = 0; valid && i < (int)SpriteId::COUNT; ++i) {
+        valid = found[i] && importedHashes[i] == SourceHash(SPRITE_SOURCES[i].fileName);
+    }
+    if (!valid) {
+        GAME_LOG_WARNING(LogCategory::ASSETS, "Atlas table %s is out of date, packing at startup", tablePath);
+        return false;
+    }
+
+    std::vector<Image> images;
+    for (int page = 0; page < pageCount; ++page) {
+        Image image = TextureCacheLoad(AtlasPagePath(tablePath, page).c_str());
+        if (!IsImageValid(image)) {
+            for (Image& loaded : images) UnloadImage(loaded);
+            return false;
+        }
+        images.push_back(image);
+    }
+
+    pageImages.swap(images);
+    for (int i = 0; i < (int)SpriteId::COUNT; ++i) {
+        sprites[i] = imported[i];
+        sourceHashes[i] = importedHashes[i];
+    }
+    return true;
+}
+
+void TextureAtlas::Upload() {
+    for (Image& image : pageImages) {
+        pageTextures.push_back(RenderLoadTextureFromImage(image));
+        UnloadImage(image);
+    }
+    pageImages.clear();
+}
+
+void TextureAtlas::Unload() {
+    for (Image& image : spriteImages) {
+        UnloadImage(image);
+        image = Image{};
+    }
+    for (Image& image : pageImages) UnloadImage(image);
+    for (Texture2D& texture : pageTextures) RenderUnloadTexture(texture);
+    pageImages.clear();
+    pageTextures.clear();
+}
+
+Texture2D TextureAtlas::GetSpriteTexture(SpriteId id) const {
+    const AtlasSprite& sprite = sprites[(int)id];
+    if (sprite.page < 0 || sprite.page >= (int)pageTextures.size()) return Texture2D{};
+    Texture2D texture = pageTextures[sprite.page];
+    texture.width = (int)sprite.source.width;
+    texture.height = (int)sprite.source.height;
+    return texture;
+}
+
+bool TextureAtlas::Resolve(SpriteId id, Rectangle source, Texture2D& outTexture, Rectangle& outSource) const {
+    if (id == SpriteId::COUNT) return false;
+    const AtlasSprite& sprite = sprites[(int)id];
+    if (sprite.page < 0 || sprite.page >= (int)pageTextures.size()) return false;
+
+    outTexture = pageTextures[sprite.page];
+    outSource = { sprite.source.x + source.x, sprite.source.y + source.y, source.width, source.height };
+    return true;
+}
+
+void TextureAtlas::Draw(SpriteId id, Rectangle source, Rectangle dest, Color tint) const {
+    Texture2D texture;
+    Rectangle atlasSource;
+    if (Resolve(id, source, texture, atlasSource)) {
+        RenderTexturedRect(texture, atlasSource, dest, tint);
+    }
+}
+
+void TextureAtlas::DrawEx(SpriteId id, Vector2 position, float scale, Color tint) const {
+    if (id == SpriteId::COUNT) return;
+    const AtlasSprite& sprite = sprites[(int)id];
+    Rectangle source = { 0, 0, sprite.source.width, sprite.source.height };
+    Draw(id, source, (Rectangle){ position.x, position.y, sprite.source.width * scale, sprite.source.height * scale }, tint);
+}
@@ -0,0 +1,118 @@
+// texture_atlas.h
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+#include <string>
+
+//----------------------------------------------------------------------------------
+// Texture Atlas
+// Every lawn and HUD sprite is packed into one or two large page textures, so
+// drawing them no longer switches textures and raylib's batch keeps growing
+// instead of being flushed per sprite. Sprites are addressed by SpriteId; the
+// table below lists the file each one comes from.
+//
+// Packing only needs CPU images, no window: tools/pack_atlas.cpp runs it
+// offline and exports the pages plus a table that the game imports at startup.
+// The table records a hash of every sprite's source file. Without an exported
+// atlas, or when the table no longer matches SPRITE_SOURCES or the files, the
+// game packs at startup instead. Sprites, table and pages are read from the asset
+// archive when there is one (see asset_archive.h). Full-screen backgrounds are
+// not atlased: they are drawn once per frame anyway and would take a page each.
+//----------------------------------------------------------------------------------
+enum class SpriteId {
+    PEASHOOTER,
+    SUNFLOWER,
+    CHERRY_BOMB,
+    WALNUT,
+    REPEATER,
+    ICE_PEA,
+    SHOVEL,
+    REGULAR_ZOMBIE,
+    JUMPING_ZOMBIE,
+    PEA,          // Normal and frozen peas share the sprite
+    LAWNMOWER,
+    PAUSE_BUTTON,
+    MUTE,
+    UNMUTE,
+    COUNT         // Also "no sprite"
+};
+
+struct SpriteSource {
+    SpriteId id;
+    const char* name;     // Key in the exported table
+    const char* fileName;
+};
+
+// Indexed by SpriteId
+const SpriteSource SPRITE_SOURCES[(int)SpriteId::COUNT] = {
+    { SpriteId::PEASHOOTER,     "peashooter",     "resources/peashooter.png" },
+    { SpriteId::SUNFLOWER,      "sunflower",      "resources/sunflower.png" },
+    { SpriteId::CHERRY_BOMB,    "cherrybomb",     "resources/cherrybomb.png" },
+    { SpriteId::WALNUT,         "wallnut",        "resources/wallnut.png" },
+    { SpriteId::REPEATER,       "repeater",       "resources/repeater.png" },
+    { SpriteId::ICE_PEA,        "icepea",         "resources/icepea.png" },
+    { SpriteId::SHOVEL,         "shovel",         "resources/shovel.png" },
+    { SpriteId::REGULAR_ZOMBIE, "regular_zombie", "resources/regular_zombie.png" },
+    { SpriteId::JUMPING_ZOMBIE, "jumping_zombie", "resources/jumping_zombie.png" },
+    { SpriteId::PEA,            "pea",            "resources/Pea.png" },
+    { SpriteId::LAWNMOWER,      "lawnmower",      "resources/lawnmower.png" },
+    { SpriteId::PAUSE_BUTTON,   "pause_button",   "resources/pause_button.png" },
+    { SpriteId::MUTE,           "mute",           "resources/mute.png" },
+    { SpriteId::UNMUTE,         "unmute",         "resources/unmute.jpg" },
+};
+
+const int ATLAS_PAGE_SIZE = 1024;   // Width and height of every page, in pixels
+const int ATLAS_PADDING = 2;        // Empty pixels around each sprite, keeps filtering from bleeding
+const char* const ATLAS_TABLE_PATH = "resources/atlas.txt"; // Pages go next to it as atlas_<n>.png
+
+// Page image 'page' of the atlas exported to 'tablePath'
+std::string AtlasPagePath(const char* tablePath, int page);
+
+struct AtlasSprite {
+    int page;          // -1 if the sprite's file could not be loaded
+    Rectangle source;  // Pixels in the page texture
+};
+
+class TextureAtlas {
+public:
+    TextureAtlas();
+
+    // CPU side, works without a window
+    bool Pack(int pageSize);                 // LoadSprite for every sprite, then PackLoaded
+    // The same in steps: each sprite may be decoded on its own loader thread, then
+    // PackLoaded runs once all of them are done and frees the decoded images
+    bool LoadSprite(SpriteId id);            // False if its file is missing
+    bool PackLoaded(int pageSize);
+    bool Export(const char* tablePath) const;
+    bool Import(const char* tablePath);      // False if missing or not matching SPRITE_SOURCES and their files
+
+    // GPU side, after InitWindow: turns the page images into textures and frees the images
+    void Upload();
+    void Unload();
+
+    const AtlasSprite& GetSprite(SpriteId id) const { return sprites[(int)id]; }
+    int GetPageCount() const { return (int)pageTextures.size(); }
+    const Texture2D& GetPageTexture(int page) const { return pageTextures[page]; }
+    // Texture sized like the sprite (width, height) for frame math; only the atlas can draw it
+    Texture2D GetSpriteTexture(SpriteId id) const;
+
+    // Page texture and page pixels for a rect relative to the sprite, false if the sprite is missing
+    bool Resolve(SpriteId id, Rectangle source, Texture2D& outTexture, Rectangle& outSource) const;
+
+    // 'source' is relative to the sprite, like a source rect into the original file
+    void Draw(SpriteId id, Rectangle source, Rectangle dest, Color tint) const;
+    // Whole sprite at 'position', scaled like DrawTextureEx
+    void DrawEx(SpriteId id, Vector2 position, float scale, Color tint) const;
+
+private:
+    Image spriteImages[(int)SpriteId::COUNT]; // Between LoadSprite and PackLoaded
+    std::vector<Image> pageImages;       // Between Pack/Import and Upload
+    std::vector<Texture2D> pageTextures;
+    AtlasSprite sprites[(int)SpriteId::COUNT];
+    uint64_t sourceHashes[(int)SpriteId::COUNT]; // Of the files the sprites were packed from, 0 if missing
+};
+
+#endif // TEXTURE_ATLAS_H
@@ -0,0 +1,113 @@
+// texture_cache.cpp
+#include "texture_cache.h"
+#include "asset_archive.h"
+#include "logger.h"
+#include <cstdio>    // For fopen, fread, fwrite, rename, remove, snprintf
+#include <cctype>    // For isalnum
+#include <string>
+
+namespace {
+    // <cache dir>/<escaped path>[@<width>x<height>].rgba, the whole path with its
+    // extension. Separators and other unusual characters become %XX ('\\' like
+    // '/'), so no two sources or sizes share a file.
+    std::string CachePath(const char* fileName, int width, int height) {
+        std::string name;
+        for (const char* c = fileName; *c; ++c) {
+            char ch = (*c == '\\') ? '/' : *c;
+            if (isalnum((unsigned char)ch) || ch == '.' || ch == '_' || ch == '-') {
+                name += ch;
+            } else {
+                char escaped[4];
+                snprintf(escaped, sizeof(escaped), "%%%02X", (unsigned char)ch);
+                name += escaped;
+            }
+        }
+        if (width > 0) name += "@" + std::to_string(width) + "x" + std::to_string(height);
+        return std::string(TEXTURE_CACHE_DIR) + "/" + name + ".rgba";
+    }
+
+    // The cached pixels if they were made from a source hashing to 'sourceHash', an empty Image otherwise
+    Image ReadCached(const std::string& path, uint64_t sourceHash, int width, int height) {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file) return Image{};
+
+        Image image = {};
+        TextureCacheHeader header;
+        bool current = fread(&header, sizeof(header), 1, file) == 1
+                       && header.magic == TEXTURE_CACHE_MAGIC && header.version == TEXTURE_CACHE_VERSION
+                       && header.sourceHash == sourceHash
+                       && header.width > 0 && header.width <= (uint32_t)TEXTURE_CACHE_MAX_SIZE
+                       && header.height > 0 && header.height <= (uint32_t)TEXTURE_CACHE_MAX_SIZE
+                       && (width == 0 || ((int)header.width == width && (int)header.height == height));
+        if (current) {
+            size_t size = (size_t)header.width * header.height * 4;
+            void* pixels = MemAlloc((unsigned int)size);
+            if (fread(pixels, 1, size, file) == size) {
+                image = { pixels, (int)header.width, (int)header.height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+            } else {
+                MemFree(pixels);
+            }
+        }
+        fclose(file);
+        return image;
+    }
+
+    // Written aside and renamed into place, so a run killed halfway never leaves a torn file
+    bool WriteCached(const std::string& path, uint64_t sourceHash, const Image& image) {
+        if (!DirectoryExists(TEXTURE_CACHE_DIR)) MakeDirectory(TEXTURE_CACHE_DIR);
+        std::string partPath = path + ".part";
+        FILE* file = fopen(partPath.c_str(), "wb");
+        if (!file) return false;
+
+        TextureCacheHeader header = { TEXTURE_CACHE_MAGIC, TEXTURE_CACHE_VERSION, (uint32_t)image.width, (uint32_t)image.height, sourceHash };
+        size_t size = (size_t)image.width * image.height * 4;
+        bool written = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(image.data, 1, size, file) == size;
+        written = fclose(file) == 0 && written;
+        remove(path.c_str()); // rename does not replace an existing file on Windows
+        if (!written || rename(partPath.c_str(), path.c_str()) != 0) {
+            remove(partPath.c_str());
+            return false;
+        }
+        return true;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Texture Cache Implementation
+//----------------------------------------------------------------------------------
+Image TextureCacheLoad(const char* fileName, int width, int height) {
+    // The source is only hashed, and decoded on a miss: mapped from the archive or read loose
+    const unsigned char* source = nullptr;
+    unsigned char* looseData = nullptr;
+    int sourceSize = 0;
+    uint64_t sourceHash = 0;
+    if (ArchiveIsOpen()) {
+        const ArchiveEntry* entry = ArchiveFind(fileName);
+        if (!entry) return ArchiveLoadImage(fileName); // Warns that it was never packed
+        source = ArchiveGetData(*entry);
+        sourceSize = (int)entry->size;
+        sourceHash = entry->hash;
+    } else {
+        looseData = LoadFileData(fileName, &sourceSize);
+        if (!looseData) return Image{};
+        source = looseData;
+        sourceHash = ArchiveHash(looseData, (size_t)sourceSize);
+    }
+
+    std::string path = CachePath(fileName, width, height);
+    Image image = ReadCached(path, sourceHash, width, height);
+    if (!IsImageValid(image)) {
+        image = LoadImageFromMemory(GetFileExtension(fileName), source, sourceSize);
+        if (IsImageValid(image)) {
+            ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+            if (width > 0 && (image.width != width || image.height != height)) ImageResize(&image, width, height);
+            if (WriteCached(path, sourceHash, image)) {
+                GAME_LOG_INFO(LogCategory::ASSETS, "Cached %s as %dx%d RGBA in %s", fileName, image.width, image.height, path.c_str());
+            } else {
+                GAME_LOG_WARNING(LogCategory::ASSETS, "Could not write the texture cache file %s", path.c_str());
+            }
+        }
+    }
+    UnloadFileData(looseData);
+    return image;
+}
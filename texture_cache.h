@@ -0,0 +1,40 @@
+// texture_cache.h
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include "raylib.h"
+#include <cstdint>
+
+//----------------------------------------------------------------------------------
+// Texture Cache
+// The PNGs never change between launches, yet every launch decoded them again
+// and then scaled the full-screen ones down on the GPU every frame. The first
+// run decodes each image once, resizes it to the size it is drawn at and
+// stores the raw RGBA pixels under TEXTURE_CACHE_DIR. Later runs read those
+// pixels straight into an Image that uploads as is, with no decoding.
+//
+// Every cache file records the hash of the source file it was made from (the
+// archive entry's hash, or the loose file's). When the source changes the hash
+// no longer matches, and the file is decoded and written again.
+//----------------------------------------------------------------------------------
+const char* const TEXTURE_CACHE_DIR = "resources/cache";
+const uint32_t TEXTURE_CACHE_MAGIC = 0x43545A50;  // "PZTC"
+const uint32_t TEXTURE_CACHE_VERSION = 1;
+const int TEXTURE_CACHE_MAX_SIZE = 8192;          // Larger sizes in a header mean a damaged file
+
+// Followed by width * height RGBA pixels
+struct TextureCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint64_t sourceHash;
+};
+
+static_assert(sizeof(TextureCacheHeader) == 24, "TextureCacheHeader is written as is");
+
+// Image 'fileName' as R8G8B8A8, resized to width x height (0 keeps its own size).
+// From the cache when it is up to date, otherwise decoded and cached. Safe on loader threads.
+Image TextureCacheLoad(const char* fileName, int width = 0, int height = 0);
+
+#endif // TEXTURE_CACHE_H
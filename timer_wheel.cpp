@@ -0,0 +1,138 @@
+// timer_wheel.cpp
+#include "timer_wheel.h"
+#include <cmath> // For std::ceil
+
+//----------------------------------------------------------------------------------
+// Timer Wheel Implementation
+//----------------------------------------------------------------------------------
+TimerWheel::TimerWheel(float tickSeconds)
+    : now(0), tickSeconds(tickSeconds), accumulator(0.0f), pendingCount(0)
+{
+    for (int& head : heads) head = -1;
+}
+
+void TimerWheel::Link(int index) {
+    Node& node = nodes[index];
+    unsigned long long delta = node.deadline - now;
+
+    // Pick the finest level whose span still covers the deadline
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (1ULL << (SLOT_BITS * (level + 1)))) ++level;
+    if (delta >= (1ULL << (SLOT_BITS * LEVELS))) {
+        // Beyond the top wheel (about 38 hours at 120 ticks/s): clamp to its span
+        node.deadline = now + (1ULL << (SLOT_BITS * LEVELS)) - 1;
+    }
+    int slot = (int)((node.deadline >> (SLOT_BITS * level)) & (SLOTS - 1));
+
+    node.bucket = level * SLOTS + slot;
+    node.prev = -1;
+    node.next = heads[node.bucket];
+    if (node.next >= 0) nodes[node.next].prev = index;
+    heads[node.bucket] = index;
+}
+
+void TimerWheel::Unlink(int index) {
+    Node& node = nodes[index];
+    if (node.prev >= 0) nodes[node.prev].next = node.next;
+    else heads[node.bucket] = node.next;
+    if (node.next >= 0) nodes[node.next].prev = node.prev;
+    node.bucket = -1;
+}
+
+void TimerWheel::Release(int index) {
+    nodes[index].generation++; // Invalidates every handle to this node
+    nodes[index].bucket = -1;
+    freeNodes.push_back(index);
+    --pendingCount;
+}
+
+TimerHandle TimerWheel::Schedule(float delaySeconds, TimerKind kind, void* owner) {
+    int index;
+    if (!freeNodes.empty()) {
+        index = freeNodes.back();
+        freeNodes.pop_back();
+    } else {
+        index = (int)nodes.size();
+        nodes.push_back(Node());
+        nodes[index].generation = 0;
+    }
+
+    long long ticks = (long long)std::ceil(delaySeconds / tickSeconds);
+    if (ticks < 1) ticks = 1; // Never fire during the tick that scheduled it
+
+    Node& node = nodes[index];
+    node.deadline = now + (unsigned long long)ticks;
+    node.owner = owner;
+    node.kind = kind;
+    Link(index);
+    ++pendingCount;
+
+    TimerHandle handle;
+    handle.node = index;
+    handle.generation = node.generation;
+    return handle;
+}
+
+bool TimerWheel::IsPending(const TimerHandle& handle) const {
+    return handle.node >= 0 && handle.node < (int)nodes.size() &&
+           nodes[handle.node].generation == handle.generation && nodes[handle.node].bucket >= 0;
+}
+
+void TimerWheel::Cancel(TimerHandle& handle) {
+    if (IsPending(handle)) {
+        Unlink(handle.node);
+        Release(handle.node);
+    }
+    handle.node = -1;
+}
+
+void TimerWheel::Cascade(int level) {
+    int bucket = level * SLOTS + (int)((now >> (SLOT_BITS * level)) & (SLOTS - 1));
+    int index = heads[bucket];
+    heads[bucket] = -1;
+
+    // Re-link every node of the slot relative to the new time, they land on finer levels
+    while (index >= 0) {
+        int next = nodes[index].next;
+        Link(index);
+        index = next;
+    }
+}
+
+void TimerWheel::Advance(float deltaTime, std::vector<FiredTimer>& fired) {
+    accumulator += deltaTime;
+
+    while (accumulator >= tickSeconds) {
+        accumulator -= tickSeconds;
+        ++now;
+
+        // When a finer wheel wraps around, pull the next slot of the coarser one down
+        for (int level = 1; level < LEVELS; ++level) {
+            if ((now & ((1ULL << (SLOT_BITS * level)) - 1)) != 0) break;
+            Cascade(level);
+        }
+
+        // Everything in the current level 0 slot is due exactly now
+        int bucket = (int)(now & (SLOTS - 1));
+        int index = heads[bucket];
+        heads[bucket] = -1;
+        while (index >= 0) {
+            int next = nodes[index].next;
+            fired.push_back({ nodes[index].kind, nodes[index].owner });
+            Release(index);
+            index = next;
+        }
+    }
+}
+
+void TimerWheel::Clear() {
+    for (int& head : heads) head = -1;
+    freeNodes.clear();
+    for (int i = (int)nodes.size() - 1; i >= 0; --i) {
+        nodes[i].generation++;
+        nodes[i].bucket = -1;
+        freeNodes.push_back(i);
+    }
+    pendingCount = 0;
+    accumulator = 0.0f;
+}
@@ -0,0 +1,82 @@
+// timer_wheel.h
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <vector>
+#include <cstddef> // For size_t
+
+//----------------------------------------------------------------------------------
+// Timer Wheel
+// Central store for every gameplay deadline (fire rate, sun production, fuse,
+// bites). Entities register a deadline once instead of
+// accumulating deltaTime every frame, and Advance only touches the timers that
+// actually expire, so idle plants cost nothing per frame.
+//
+// Hierarchical layout: LEVELS wheels of SLOTS slots. Level 0 has one slot per
+// tick, every level above covers SLOTS times the span of the one below. Far
+// deadlines sit in coarse slots and cascade down as time approaches them.
+//----------------------------------------------------------------------------------
+enum class TimerKind {
+    PLANT_FIRE,
+    SUN_PRODUCTION,
+    CHERRY_FUSE,
+    ZOMBIE_BITE,
+    ZOMBIE_COARSE_STEP  // Dormant zombies only, handled by the Simulation
+};
+
+struct TimerHandle {
+    int node = -1;              // -1 when nothing is scheduled
+    unsigned int generation = 0; // Must match the node's generation to still be pending
+};
+
+struct FiredTimer {
+    TimerKind kind;
+    void* owner;
+};
+
+class TimerWheel {
+public:
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const int LEVELS = 4;
+
+    explicit TimerWheel(float tickSeconds);
+
+    // Fires after at least 'delaySeconds', rounded up to the next tick
+    TimerHandle Schedule(float delaySeconds, TimerKind kind, void* owner);
+    // Safe on handles that already fired or were cancelled
+    void Cancel(TimerHandle& handle);
+    bool IsPending(const TimerHandle& handle) const;
+
+    // Runs the clock forward and appends every timer that expired, in deadline order
+    void Advance(float deltaTime, std::vector<FiredTimer>& fired);
+    void Clear();
+
+    size_t GetPendingCount() const { return pendingCount; }
+
+private:
+    struct Node {
+        unsigned long long deadline; // In ticks
+        void* owner;
+        TimerKind kind;
+        unsigned int generation;
+        int prev;
+        int next;
+        int bucket; // level * SLOTS + slot, -1 when free
+    };
+
+    void Link(int index);
+    void Unlink(int index);
+    void Release(int index);
+    void Cascade(int level);
+
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    int heads[LEVELS * SLOTS];
+    unsigned long long now; // Current tick
+    float tickSeconds;
+    float accumulator;      // Time not yet converted to whole ticks
+    size_t pendingCount;
+};
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,74 @@
+// pack_assets.cpp
+// Offline asset packer: run from the game's root directory, after pack_atlas.
+// Packs every file in SPRITE_SOURCES and asset_manifest.h, plus the exported
+// atlas, into the archive the game maps at startup. Missing sprites and
+// backgrounds fail the pack; missing sounds, music and atlas files are only
+// reported, unless --strict is given.
+//     pack_assets [archive path, default resources/assets.pak] [--strict]
+#include "../asset_archive.h"
+#include "../asset_manifest.h"
+#include "../logger.h"
+#include <cstdio>    // For sscanf
+#include <cstring>   // For strcmp
+
+namespace {
+    // Adds 'fileName' to the archive, false if it could not be read
+    bool AddFile(ArchiveBuilder& builder, const char* fileName, ArchiveEntryType type, bool required) {
+        if (!FileExists(fileName)) {
+            GAME_LOG_WARNING(LogCategory::ASSETS, required ? "Missing %s" : "Missing %s, the game runs without it", fileName);
+            return false;
+        }
+        int size = 0;
+        unsigned char* data = LoadFileData(fileName, &size);
+        bool added = data && builder.Add(fileName, type, data, size);
+        UnloadFileData(data);
+        if (!added) GAME_LOG_WARNING(LogCategory::ASSETS, "Could not pack %s", fileName);
+        return added;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* archivePath = ASSET_ARCHIVE_PATH;
+    bool strict = false;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--strict") == 0) strict = true;
+        else archivePath = argv[i];
+    }
+
+    LogStart();
+    ArchiveBuilder builder;
+    bool complete = true;
+    bool optionalComplete = true;
+    for (int i = 0; i < (int)SpriteId::COUNT; ++i) {
+        complete = AddFile(builder, SPRITE_SOURCES[i].fileName, ArchiveEntryType::IMAGE, true) && complete;
+    }
+    for (int i = 0; i < (int)BackgroundId::COUNT; ++i) {
+        complete = AddFile(builder, BACKGROUND_SOURCES[i], ArchiveEntryType::IMAGE, true) && complete;
+    }
+    for (int i = 0; i < SOUND_SOURCE_COUNT; ++i) {
+        optionalComplete = AddFile(builder, SOUND_SOURCES[i].fileName, ArchiveEntryType::WAVE, strict) && optionalComplete;
+    }
+    optionalComplete = AddFile(builder, MUSIC_SOURCE, ArchiveEntryType::MUSIC, strict) && optionalComplete;
+
+    // The exported atlas, so the game imports it instead of packing at startup
+    std::string table;
+    int pageCount = 0;
+    if (AddFile(builder, ATLAS_TABLE_PATH, ArchiveEntryType::TEXT, strict) && ArchiveLoadText(ATLAS_TABLE_PATH, table)
+        && sscanf(table.c_str(), "pages %d", &pageCount) == 1) {
+        for (int page = 0; page < pageCount; ++page) {
+            optionalComplete = AddFile(builder, AtlasPagePath(ATLAS_TABLE_PATH, page).c_str(), ArchiveEntryType::IMAGE, strict) && optionalComplete;
+        }
+    }
+    else {
+        optionalComplete = false;
+    }
+
+    if (strict) complete = complete && optionalComplete;
+    bool written = complete && builder.Write(archivePath);
+    if (written) GAME_LOG_INFO(LogCategory::ASSETS, "%d files packed into %s", builder.GetCount(), archivePath);
+    else GAME_LOG_CRITICAL(LogCategory::ASSETS, "Could not pack the assets into %s", archivePath);
+    LogStop();
+
+    return written ? 0 : 1;
+}
@@ -0,0 +1,21 @@
+// pack_atlas.cpp
+// Offline atlas packer: run from the game's root directory. Packs every sprite in
+// SPRITE_SOURCES and writes the pages and the table the game imports at startup.
+//     pack_atlas [table path, default resources/atlas.txt]
+#include "../texture_atlas.h"
+#include "../logger.h"
+
+int main(int argc, char** argv)
+{
+    const char* tablePath = argc > 1 ? argv[1] : ATLAS_TABLE_PATH;
+
+    LogStart();
+    TextureAtlas atlas;
+    bool packed = atlas.Pack(ATLAS_PAGE_SIZE) && atlas.Export(tablePath);
+    if (packed) GAME_LOG_INFO(LogCategory::ASSETS, "Atlas written to %s", tablePath);
+    else GAME_LOG_CRITICAL(LogCategory::ASSETS, "Could not pack the atlas into %s", tablePath);
+    atlas.Unload();
+    LogStop();
+
+    return packed ? 0 : 1;
+}
@@ -0,0 +1,47 @@
+// triple_buffer.h
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+//----------------------------------------------------------------------------------
+// Triple Buffer
+// Hands the latest value from one writer thread to one reader thread without
+// either side ever waiting. The writer fills its own buffer and swaps it with
+// the shared middle one (Publish); the reader swaps its buffer with the middle
+// one only when something new was published (Acquire). Neither thread ever sees
+// the buffer the other one is using. Values the reader was too slow to pick up
+// are simply overwritten, it always gets the most recent one.
+//----------------------------------------------------------------------------------
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : writeIndex(0), middle(1), readIndex(2) {}
+
+    // Writer side: fill this buffer completely, then Publish it
+    T& GetWriteBuffer() { return buffers[writeIndex]; }
+    void Publish() {
+        unsigned int previous = middle.exchange(writeIndex | FRESH_BIT, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK; // Whatever the reader left behind, possibly never read
+    }
+
+    // Reader side: true if a newer buffer replaced the one returned by GetReadBuffer
+    bool Acquire() {
+        if ((middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0) return false;
+        unsigned int previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+    const T& GetReadBuffer() const { return buffers[readIndex]; }
+
+private:
+    static const unsigned int INDEX_MASK = 3u;
+    static const unsigned int FRESH_BIT = 4u; // Set while the middle buffer hasn't been read
+
+    T buffers[3];
+    alignas(64) unsigned int writeIndex;           // Only touched by the writer
+    alignas(64) std::atomic<unsigned int> middle;  // Index of the shared buffer plus FRESH_BIT
+    alignas(64) unsigned int readIndex;            // Only touched by the reader
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -0,0 +1,85 @@
+// ui_layout.cpp
+#include "ui_layout.h"
+#include "render_device.h"
+
+//----------------------------------------------------------------------------------
+// UI Layout Implementation
+//----------------------------------------------------------------------------------
+UiLayout::UiLayout() : columns(0), rows(0) {}
+
+void UiLayout::Add(const UiWidget& widget) {
+    widgets.push_back(widget);
+}
+
+void UiLayout::Build(int width, int height) {
+    columns = (width + UI_HIT_CELL_SIZE - 1) / UI_HIT_CELL_SIZE;
+    rows = (height + UI_HIT_CELL_SIZE - 1) / UI_HIT_CELL_SIZE;
+    int cellCount = columns * rows;
+
+    for (HitGrid& grid : grids) {
+        grid.cellStart.assign(cellCount + 1, 0);
+        grid.cellWidgets.clear();
+    }
+
+    // Count per cell, turn the counts into start offsets, then fill in widget order
+    int firstX, firstY, lastX, lastY;
+    for (const UiWidget& widget : widgets) {
+        if (!GetCellRange(widget.rect, firstX, firstY, lastX, lastY)) continue;
+        HitGrid& grid = grids[widget.screen];
+        for (int y = firstY; y <= lastY; ++y) {
+            for (int x = firstX; x <= lastX; ++x) grid.cellStart[y * columns + x + 1]++;
+        }
+    }
+    for (HitGrid& grid : grids) {
+        for (int cell = 0; cell < cellCount; ++cell) grid.cellStart[cell + 1] += grid.cellStart[cell];
+        grid.cellWidgets.resize(grid.cellStart[cellCount]);
+    }
+
+    std::vector<int> filled(cellCount);
+    for (int screen = 0; screen < UI_SCREEN_COUNT; ++screen) {
+        HitGrid& grid = grids[screen];
+        for (int cell = 0; cell < cellCount; ++cell) filled[cell] = grid.cellStart[cell];
+        for (int i = 0; i < (int)widgets.size(); ++i) {
+            if (widgets[i].screen != screen || !GetCellRange(widgets[i].rect, firstX, firstY, lastX, lastY)) continue;
+            for (int y = firstY; y <= lastY; ++y) {
+                for (int x = firstX; x <= lastX; ++x) grid.cellWidgets[filled[y * columns + x]++] = i;
+            }
+        }
+    }
+}
+
+const UiWidget* UiLayout::HitTest(GameState screen, Vector2 point) const {
+    if (point.x < 0 || point.y < 0) return nullptr;
+    int x = (int)point.x / UI_HIT_CELL_SIZE;
+    int y = (int)point.y / UI_HIT_CELL_SIZE;
+    if (x >= columns || y >= rows) return nullptr;
+
+    const HitGrid& grid = grids[screen];
+    int cell = y * columns + x;
+    for (int i = grid.cellStart[cell]; i < grid.cellStart[cell + 1]; ++i) {
+        const UiWidget& widget = widgets[grid.cellWidgets[i]];
+        if (CheckCollisionPointRec(point, widget.rect)) return &widget;
+    }
+    return nullptr;
+}
+
+void UiLayout::DrawButtons(GameState screen, const TextCache& text) const {
+    for (const UiWidget& widget : widgets) {
+        if (widget.screen != screen || widget.label < 0) continue;
+        RenderRect(widget.rect, widget.color);
+        text.DrawCentered(widget.label, widget.rect, widget.labelColor);
+    }
+}
+
+bool UiLayout::GetCellRange(Rectangle rect, int& firstX, int& firstY, int& lastX, int& lastY) const {
+    if (rect.width <= 0 || rect.height <= 0) return false;
+    firstX = (int)rect.x / UI_HIT_CELL_SIZE;
+    firstY = (int)rect.y / UI_HIT_CELL_SIZE;
+    lastX = (int)(rect.x + rect.width) / UI_HIT_CELL_SIZE;
+    lastY = (int)(rect.y + rect.height) / UI_HIT_CELL_SIZE;
+    if (firstX < 0) firstX = 0;
+    if (firstY < 0) firstY = 0;
+    if (lastX >= columns) lastX = columns - 1;
+    if (lastY >= rows) lastY = rows - 1;
+    return firstX <= lastX && firstY <= lastY;
+}
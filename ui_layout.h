@@ -0,0 +1,82 @@
+// ui_layout.h
+#ifndef UI_LAYOUT_H
+#define UI_LAYOUT_H
+
+#include "raylib.h"
+#include <vector>
+#include "game_state.h"
+#include "plant.h"      // For PlantType
+#include "text_cache.h"
+
+//----------------------------------------------------------------------------------
+// UI Layout
+// Every clickable thing on every screen (menu buttons, the seed bar, pause and
+// mute, the lawn itself) is one row of a retained widget table, built once at
+// startup. The same rows are what gets drawn and what gets hit-tested, so the
+// two can't drift apart, and adding a plant to the seed bar is one more row.
+//
+// Clicks are routed through a uniform grid per screen: each UI_HIT_CELL_SIZE
+// cell lists the widgets overlapping it, so a hit test only looks at the one
+// cell under the mouse. Where widgets overlap, the one added first wins.
+//----------------------------------------------------------------------------------
+const int UI_SCREEN_COUNT = LEVEL_UP_SCREEN + 1; // One widget set per GameState
+const int UI_HIT_CELL_SIZE = 80;                 // Pixels, square cells
+
+enum class UiAction {
+    PLAY,
+    EXIT,
+    PAUSE,
+    TOGGLE_MUTE,
+    SELECT_PLANT, // 'plant' says which
+    LAWN,         // The planting grid, the tile follows from the click position
+    RESUME,
+    MAIN_MENU,
+    CONTINUE,
+    REPLAY
+};
+
+struct UiWidget {
+    GameState screen;
+    UiAction action;
+    Rectangle rect;
+    PlantType plant;   // SELECT_PLANT only, NONE otherwise
+    Color color;       // Button fill, BLANK for widgets drawn elsewhere (HUD, lawn)
+    TextRunId label;   // Centered on the button, -1 for none
+    Color labelColor;
+};
+
+class UiLayout {
+public:
+    UiLayout();
+
+    // Widgets can only be added before Build
+    void Add(const UiWidget& widget);
+    // Sorts the widgets into the hit grids, 'width' x 'height' being the screen
+    void Build(int width, int height);
+
+    // Widget of 'screen' under 'point', nullptr if none
+    const UiWidget* HitTest(GameState screen, Vector2 point) const;
+
+    // Filled buttons with their labels, in the order they were added
+    void DrawButtons(GameState screen, const TextCache& text) const;
+
+    int GetCount() const { return (int)widgets.size(); }
+    const UiWidget& Get(int index) const { return widgets[index]; }
+
+private:
+    // Cell c lists widgets[cellStart[c]] .. widgets[cellStart[c + 1] - 1], in added order
+    struct HitGrid {
+        std::vector<int> cellStart;
+        std::vector<int> cellWidgets;
+    };
+
+    // Cells covered by 'rect', clamped to the grid; false if none
+    bool GetCellRange(Rectangle rect, int& firstX, int& firstY, int& lastX, int& lastY) const;
+
+    std::vector<UiWidget> widgets;
+    HitGrid grids[UI_SCREEN_COUNT];
+    int columns;
+    int rows;
+};
+
+#endif // UI_LAYOUT_H
@@ -6,9 +6,15 @@
 #include <vector>
 #include <memory> // For std::unique_ptr
 #include "game_constants.h"
+#include "broadphase.h"
+#include "timer_wheel.h"
+#include "status_effects.h"
+#include "sim_context.h"
+#include "animation.h"
 
 // Forward declaration for Plant
 class Plant;
+struct ZombieArchetype; // Stats table row, see archetypes.h
 
 // Enum to differentiate zombie types
 enum class ZombieType {
@@ -24,41 +30,55 @@ public:
     // Reordered members to match the constructor initialization order in zombie.cpp
     Rectangle rect;
     int health;
-    float speed;
+    float speed;           // Effective speed: baseSpeed scaled by the active status effects
     bool active;
     Color color; // Fallback color, will be overridden by texture
-    Texture2D texture; // Sprite sheet for the zombie
-    Rectangle sourceRect; // Current frame in the sprite sheet
-    int currentFrame;
-    float frameTimer;
-    float frameSpeed;
-    int numFrames;         // Total horizontal frames in *one* row
-    int numSpriteRows;     // Total number of rows in the sprite sheet
-    int currentRowIndex;   // Which row to animate from (0 for top, 1 for next, etc.)
+    AnimClipId clip;       // Played from the simulation clock, see animation.h
+    float animPhase;       // Clock value the clip started at
     int row;
     bool isAttacking;      // True if currently eating a plant
-    float biteTimer;
+    TimerHandle biteTimer; // Scheduled while eating, cancelled when the zombie stops
+    bool biteReady;        // Bite timer expired, the bite lands on the next contact
     float biteRate;        // Time between bites (e.g., 0.5s per bite)
     int attackDamagePerBite; // Damage dealt per bite
     int scoreValue;        // Added this based on our previous discussion!
 
-    // --- NEW MEMBERS FOR SLOW EFFECT ---
-    bool isSlowed;
-    float slowTimer;
-    float originalSpeed;
+    // --- STATUS EFFECTS (see status_effects.h) ---
+    float baseSpeed;                                  // Speed without any effect
+    unsigned int statusMask;                          // Bit per active StatusEffectType
+    int statusRows[(int)StatusEffectType::COUNT];     // Row in StatusEffects, -1 if not active
     // -----------------------------------
 
-    // UPDATED: Added 'int level' parameter to the constructor
-    Zombie(Rectangle rect, int baseHealth, float baseSpeed, Color color, Texture2D tex, int row,
-           int numFrames, float frameSpeed, int numSpriteRows, int currentRowIndex,
-           int attackDamagePerBite, float biteRate, int scoreValue, int level);
+    // --- CONTACT SCHEDULING (see contact_scheduler.h) ---
+    bool contactCheckPending;          // True while the zombie must look for a plant every tick
+    unsigned long long contactTicket;  // Ticket of the pending wake-up event, 0 if none
+    int broadphaseId;                  // Proxy id in the Broadphase, -1 if not registered
+    // -----------------------------------
+
+    // --- LEVEL OF DETAIL (see Simulation::StepDormantZombie) ---
+    bool dormant;                      // Off-screen: coarse walking only, not animated, indexed or drawn
+    TimerHandle coarseStepTimer;       // Next coarse step, only scheduled while dormant
+    unsigned long long walkedMoves;    // Simulation move pass its x is current as of, while dormant
+    // -----------------------------------
+
+    // Stats come from the archetype, scaled for 'level' through the precomputed level table
+    Zombie(Rectangle rect, const ZombieArchetype& archetype, int row, AnimClipId clip, int level);
 
     virtual ~Zombie() = default;
 
-    virtual void Update(float deltaTime, std::vector<std::unique_ptr<Plant>>& plants) = 0;
-    virtual void Draw() const;
+    // Bites arrive here from the TimerWheel
+    void OnTimer(TimerKind kind, SimContext& ctx);
+    void CancelTimers(TimerWheel& timers); // Must be called before the zombie is destroyed
+
+    // contactPlant is the plant this zombie touches this tick (resolved by the ContactScheduler)
+    virtual void Update(float deltaTime, Plant* contactPlant, SimContext& ctx) = 0;
     virtual ZombieType GetType() const = 0;
 
+    // Broadphase footprint. Walking and jumping both stay in 'row'; a zombie that
+    // changes lanes would report both rows while crossing.
+    BroadphaseBounds GetBounds() const { return { rect.x, rect.x + rect.width, row, row }; }
+    static BroadphaseBounds BoundsOf(const void* owner) { return static_cast<const Zombie*>(owner)->GetBounds(); }
+
     void TakeDamage(int damage) { // Common function for all zombies
         health -= damage;
         if (health <= 0) {
@@ -66,12 +86,17 @@ public:
         }
     }
 
-    void AttackPlant(Plant* plant, float deltaTime);
-    void UpdateSourceRect();
+    void AttackPlant(Plant* plant, TimerWheel& timers);
+    void StopAttacking(TimerWheel& timers);
+    // Switches to 'id' from its first frame; playing it already changes nothing
+    void PlayClip(AnimClipId id, float clock);
+
+    bool HasStatus(StatusEffectType type) const { return (statusMask & (1u << (int)type)) != 0; }
+    // Frozen or stunned: neither walks nor eats
+    bool IsImmobilized() const;
 
-    // --- NEW FUNCTION FOR SLOW EFFECT ---
-    void ApplySlowEffect();
-    // ------------------------------------
+    // Speed or surroundings changed, the predicted contact time is no longer valid
+    void RequestContactCheck() { contactCheckPending = true; }
 };
 
 //----------------------------------------------------------------------------------
@@ -81,8 +106,8 @@ public:
 // RegularZombie
 class RegularZombie : public Zombie {
 public:
-    RegularZombie(Rectangle rect, int row, Texture2D tex, int level);
-    void Update(float deltaTime, std::vector<std::unique_ptr<Plant>>& plants) override;
+    RegularZombie(Rectangle rect, int row, int level);
+    void Update(float deltaTime, Plant* contactPlant, SimContext& ctx) override;
     ZombieType GetType() const override { return ZombieType::REGULAR; }
 };
 
@@ -96,8 +121,8 @@ private:
     float jumpPeakHeight;
 
 public:
-    JumpingZombie(Rectangle rect, int row, Texture2D tex, int level);
-    void Update(float deltaTime, std::vector<std::unique_ptr<Plant>>& plants) override;
+    JumpingZombie(Rectangle rect, int row, int level);
+    void Update(float deltaTime, Plant* contactPlant, SimContext& ctx) override;
     ZombieType GetType() const override { return ZombieType::JUMPING; }
 };
 